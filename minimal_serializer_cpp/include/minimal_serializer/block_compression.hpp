@@ -0,0 +1,562 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "serializer.hpp"
+#include "sink_source.hpp"
+
+namespace minimal_serializer {
+	/**
+	 * @brief A fast LZ77 class codec for blocks, whose format is similar to LZ4 block format.
+	 * A sequence is a token byte which has 4 bits of literal length and 4 bits of match length, literals, 2 bytes of match offset in little endian and extended match length.
+	 * The last sequence has only literals. Long runs of the same byte such as zero padding of strings are encoded as matches with offset 1.
+	 */
+	class lz_block_codec final {
+	public:
+		/**
+		 * @brief Get the maximum size of compressed data.
+		 * @param size The size of source data.
+		 * @return The maximum size of compressed data.
+		 */
+		static constexpr size_t max_compressed_size(const size_t size) noexcept {
+			return size + size / 255 + 16;
+		}
+
+		/**
+		 * @brief Compress data.
+		 * @param source Source data.
+		 * @param size The size of source data. This must be less than 2^32.
+		 * @param destination A destination buffer which has max_compressed_size(size) bytes.
+		 * @return The size of compressed data.
+		 */
+		size_t compress(const uint8_t* source, const size_t size, uint8_t* destination) noexcept {
+			const auto end = source + size;
+			auto anchor = source;
+			auto out = destination;
+			if (size >= min_match) {
+				table_.fill(0);
+				const auto match_limit = end - min_match;
+				auto position = source;
+				while (position <= match_limit) {
+					const auto value = load<uint32_t>(position);
+					auto& entry = table_[hash(value)];
+					const auto reference = source + entry;
+					entry = static_cast<uint32_t>(position - source);
+					if (reference >= position || static_cast<size_t>(position - reference) > max_offset ||
+						load<uint32_t>(reference) != value) {
+						// Skip faster in incompressible data.
+						position += 1 + (static_cast<size_t>(position - anchor) >> 6);
+						continue;
+					}
+
+					const auto rest = static_cast<size_t>(end - position);
+					size_t length = min_match;
+					while (length + sizeof(uint64_t) <= rest &&
+						load<uint64_t>(position + length) == load<uint64_t>(reference + length)) {
+						length += sizeof(uint64_t);
+					}
+					while (length < rest && position[length] == reference[length]) {
+						++length;
+					}
+
+					const auto literal_length = static_cast<size_t>(position - anchor);
+					out = write_token(out, literal_length, length - min_match);
+					out = write_literals(out, anchor, literal_length);
+					const auto offset = static_cast<size_t>(position - reference);
+					*out++ = static_cast<uint8_t>(offset);
+					*out++ = static_cast<uint8_t>(offset >> 8);
+					out = write_extended_length(out, length - min_match);
+					position += length;
+					anchor = position;
+				}
+			}
+
+			const auto literal_length = static_cast<size_t>(end - anchor);
+			out = write_token(out, literal_length, 0);
+			out = write_literals(out, anchor, literal_length);
+			return static_cast<size_t>(out - destination);
+		}
+
+		/**
+		 * @brief Decompress data.
+		 * @param source Compressed data.
+		 * @param source_size The size of compressed data.
+		 * @param destination A destination buffer.
+		 * @param destination_size The size of decompressed data.
+		 * @throw serialization_error Compressed data is malformed or its decompressed size is not destination_size.
+		 */
+		void decompress(const uint8_t* source, const size_t source_size, uint8_t* destination,
+						const size_t destination_size) const {
+			auto in = source;
+			const auto in_end = source + source_size;
+			auto out = destination;
+			const auto out_end = destination + destination_size;
+			while (true) {
+				if (in == in_end) {
+					throw_malformed();
+				}
+				const auto token = *in++;
+				auto literal_length = read_length(in, in_end, token >> 4);
+				if (literal_length > static_cast<size_t>(in_end - in) || literal_length > static_cast<size_t>(out_end - out)) {
+					throw_malformed();
+				}
+				if (literal_length != 0) {
+					std::memcpy(out, in, literal_length);
+					in += literal_length;
+					out += literal_length;
+				}
+				if (in == in_end) {
+					break;
+				}
+
+				if (in_end - in < 2) {
+					throw_malformed();
+				}
+				const auto offset = static_cast<size_t>(in[0]) | static_cast<size_t>(in[1]) << 8;
+				in += 2;
+				const auto length = read_length(in, in_end, token & 0x0f) + min_match;
+				if (offset == 0 || offset > static_cast<size_t>(out - destination) || length > static_cast<size_t>(out_end - out)) {
+					throw_malformed();
+				}
+				const auto match = out - offset;
+				if (offset >= length) {
+					std::memcpy(out, match, length);
+				}
+				else if (offset == 1) {
+					std::memset(out, *match, length);
+				}
+				else {
+					// Overlapping matches repeat the last offset bytes.
+					for (size_t i = 0; i < length; ++i) {
+						out[i] = match[i];
+					}
+				}
+				out += length;
+			}
+			if (out != out_end) {
+				throw_malformed();
+			}
+		}
+
+	private:
+		static constexpr size_t min_match = 4;
+		static constexpr size_t max_offset = 0xffff;
+		static constexpr size_t hash_bits = 12;
+		static constexpr uint8_t max_short_length = 0x0f;
+
+		std::array<uint32_t, 1 << hash_bits> table_{};
+
+		template <typename U>
+		static U load(const uint8_t* data) noexcept {
+			U value;
+			std::memcpy(&value, data, sizeof(U));
+			return value;
+		}
+
+		static uint32_t hash(const uint32_t value) noexcept {
+			return value * 2654435761u >> (32 - hash_bits);
+		}
+
+		static uint8_t* write_token(uint8_t* out, const size_t literal_length, const size_t match_length) noexcept {
+			*out++ = static_cast<uint8_t>(std::min<size_t>(literal_length, max_short_length) << 4 |
+				std::min<size_t>(match_length, max_short_length));
+			return out;
+		}
+
+		static uint8_t* write_extended_length(uint8_t* out, size_t length) noexcept {
+			if (length < max_short_length) {
+				return out;
+			}
+			for (length -= max_short_length; length >= 0xff; length -= 0xff) {
+				*out++ = 0xff;
+			}
+			*out++ = static_cast<uint8_t>(length);
+			return out;
+		}
+
+		static uint8_t* write_literals(uint8_t* out, const uint8_t* literals, const size_t length) noexcept {
+			out = write_extended_length(out, length);
+			if (length != 0) {
+				std::memcpy(out, literals, length);
+			}
+			return out + length;
+		}
+
+		static size_t read_length(const uint8_t*& in, const uint8_t* in_end, const size_t short_length) {
+			auto length = short_length;
+			if (short_length < max_short_length) {
+				return length;
+			}
+			while (true) {
+				if (in == in_end) {
+					throw_malformed();
+				}
+				const auto value = *in++;
+				length += value;
+				if (value != 0xff) {
+					return length;
+				}
+			}
+		}
+
+		[[noreturn]] static void throw_malformed() {
+			throw serialization_error("Compressed block is malformed.");
+		}
+	};
+
+	/**
+	 * @brief A codec which stores blocks without compression.
+	 */
+	class store_block_codec final {
+	public:
+		static constexpr size_t max_compressed_size(const size_t size) noexcept {
+			return size;
+		}
+
+		size_t compress(const uint8_t* source, const size_t size, uint8_t* destination) const noexcept {
+			std::memcpy(destination, source, size);
+			return size;
+		}
+
+		void decompress(const uint8_t* source, const size_t source_size, uint8_t* destination,
+						const size_t destination_size) const {
+			if (source_size != destination_size) {
+				throw serialization_error("Compressed block is malformed.");
+			}
+			std::memcpy(destination, source, source_size);
+		}
+	};
+
+	template <typename Codec, typename = void>
+	struct is_block_codec : std::false_type {};
+
+	template <typename Codec>
+	struct is_block_codec<Codec, std::enable_if_t<
+							std::is_same_v<decltype(Codec::max_compressed_size(size_t{})), size_t> &&
+							std::is_same_v<decltype(std::declval<Codec&>().compress(
+												std::declval<const uint8_t*>(), size_t{}, std::declval<uint8_t*>())), size_t>,
+							decltype(std::declval<const Codec&>().decompress(
+										std::declval<const uint8_t*>(), size_t{}, std::declval<uint8_t*>(), size_t{}), void())>>
+		: std::true_type {};
+
+	/**
+	 * @brief Whether the type is a codec of blocks which has "static size_t max_compressed_size(size_t)", "size_t compress(const uint8_t* source, size_t size, uint8_t* destination)" and "void decompress(const uint8_t* source, size_t source_size, uint8_t* destination, size_t destination_size) const".
+	 * decompress() throws serialization_error for malformed data.
+	 */
+	template <typename Codec>
+	constexpr bool is_block_codec_v = is_block_codec<Codec>::value;
+
+	/**
+	 * @brief An entry of the block index which locates a compressed block.
+	 */
+	struct block_index_entry final {
+		// The offset of the block from the top of the output.
+		uint64_t offset;
+		// The size of the block. If this is same as the serialized size of records, the block is stored without compression.
+		uint32_t compressed_size;
+		uint32_t record_count;
+
+		using serialize_targets = serialize_target_container<
+			&block_index_entry::offset, &block_index_entry::compressed_size, &block_index_entry::record_count>;
+	};
+
+	/**
+	 * @brief The footer at the end of the output which locates the block index.
+	 */
+	struct block_footer final {
+		static constexpr uint32_t magic_number = 0x4d53424b;
+
+		uint64_t index_offset;
+		uint64_t block_count;
+		uint32_t records_per_block;
+		uint32_t record_size;
+		uint32_t magic;
+
+		using serialize_targets = serialize_target_container<
+			&block_footer::index_offset, &block_footer::block_count, &block_footer::records_per_block,
+			&block_footer::record_size, &block_footer::magic>;
+	};
+
+	/**
+	 * @brief A writer which groups serialized records into blocks and compresses each block.
+	 * The output is compressed blocks followed by the block index and the footer, which are serialized in big endian.
+	 * A block which is not made smaller by the codec is stored without compression.
+	 * @tparam T The type of records.
+	 * @tparam Codec The codec of blocks which satisfies is_block_codec_v.
+	 * @tparam Order The byte order of serialized records.
+	 */
+	template <typename T, typename Codec = lz_block_codec, byte_order Order = byte_order::big>
+	class block_writer final {
+		static_assert(is_block_codec_v<Codec>, "Codec must satisfy is_block_codec_v.");
+
+	public:
+		/**
+		 * The serialized size of a record.
+		 */
+		static constexpr size_t record_size = serialized_size_v<T, Order>;
+
+		/**
+		 * @brief Create a writer.
+		 * @param records_per_block The number of records in a block.
+		 * @param codec The codec of blocks.
+		 */
+		explicit block_writer(const size_t records_per_block, Codec codec = Codec())
+			: records_per_block_(records_per_block), codec_(std::move(codec)) {
+			if (records_per_block == 0 || records_per_block > std::numeric_limits<uint32_t>::max() / record_size) {
+				throw std::length_error("The size of a block must be between 1 and 2^32 - 1 bytes.");
+			}
+			block_ = std::make_unique<uint8_t[]>(records_per_block * record_size);
+		}
+
+		/**
+		 * @brief Append a record. A full block is compressed and written to the sink when the next record is appended or finish() is called.
+		 * The same sink must be used until finish() is called.
+		 * If this throws, the record is not appended and the full block is kept, so appending the record again does not duplicate it.
+		 * @param obj A record to append.
+		 * @param sink A destination sink which satisfies is_serialization_sink_v.
+		 * @throw serialization_error The sink is full.
+		 */
+		template <typename Sink>
+		auto append(const T& obj, Sink& sink) -> std::enable_if_t<is_serialization_sink_v<Sink>> {
+			if (record_count_ == records_per_block_) {
+				write_block(sink);
+			}
+			serialize_impl<T, Order>(obj, block_.get() + record_count_ * record_size);
+			++record_count_;
+		}
+
+		/**
+		 * @brief Write the last block, the block index and the footer. The writer can be used for a new output after this.
+		 * @param sink A destination sink which satisfies is_serialization_sink_v.
+		 * @throw serialization_error The sink is full.
+		 */
+		template <typename Sink>
+		auto finish(Sink& sink) -> std::enable_if_t<is_serialization_sink_v<Sink>> {
+			if (record_count_ != 0) {
+				write_block(sink);
+			}
+
+			constexpr auto entry_size = serialized_size_v<block_index_entry>;
+			constexpr auto footer_size = serialized_size_v<block_footer>;
+			const auto size = index_.size() * entry_size + footer_size;
+			const auto data = reserve(sink, size);
+			for (size_t i = 0; i < index_.size(); ++i) {
+				serialize_impl<block_index_entry, byte_order::big>(index_[i], data + i * entry_size);
+			}
+			const block_footer footer{
+				offset_, index_.size(), static_cast<uint32_t>(records_per_block_), static_cast<uint32_t>(record_size),
+				block_footer::magic_number
+			};
+			serialize_impl<block_footer, byte_order::big>(footer, data + index_.size() * entry_size);
+			sink.commit(size);
+
+			index_.clear();
+			offset_ = 0;
+		}
+
+	private:
+		size_t records_per_block_;
+		Codec codec_;
+		std::unique_ptr<uint8_t[]> block_;
+		size_t record_count_ = 0;
+		uint64_t offset_ = 0;
+		std::vector<block_index_entry> index_;
+
+		template <typename Sink>
+		static uint8_t* reserve(Sink& sink, const size_t size) {
+			const auto data = sink.reserve(size);
+			if (data == nullptr) {
+				throw serialization_error("Serialization source is out of range.");
+			}
+			return data;
+		}
+
+		template <typename Sink>
+		void write_block(Sink& sink) {
+			// Compress directly into the sink, and overwrite with raw data if it is not smaller.
+			const auto raw_size = record_count_ * record_size;
+			const auto data = reserve(sink, std::max(Codec::max_compressed_size(raw_size), raw_size));
+			auto size = codec_.compress(block_.get(), raw_size, data);
+			if (size >= raw_size) {
+				std::memcpy(data, block_.get(), raw_size);
+				size = raw_size;
+			}
+			sink.commit(size);
+
+			index_.push_back({offset_, static_cast<uint32_t>(size), static_cast<uint32_t>(record_count_)});
+			offset_ += size;
+			record_count_ = 0;
+		}
+	};
+
+	/**
+	 * @brief A reader of the output of block_writer which decompresses only blocks containing requested records.
+	 * The last decompressed block is cached.
+	 * @tparam T The type of records.
+	 * @tparam Codec The codec of blocks which satisfies is_block_codec_v.
+	 * @tparam Order The byte order of serialized records.
+	 */
+	template <typename T, typename Codec = lz_block_codec, byte_order Order = byte_order::big>
+	class block_reader final {
+		static_assert(is_block_codec_v<Codec>, "Codec must satisfy is_block_codec_v.");
+
+	public:
+		/**
+		 * The serialized size of a record.
+		 */
+		static constexpr size_t record_size = serialized_size_v<T, Order>;
+
+		/**
+		 * @brief Open the output of block_writer.
+		 * @param data The output of block_writer. It must be alive while the reader is used.
+		 * @param size The size of the output.
+		 * @param codec The codec of blocks.
+		 * @throw serialization_error The output is malformed or written for other type.
+		 */
+		block_reader(const uint8_t* data, const size_t size, Codec codec = Codec())
+			: data_(data), codec_(std::move(codec)) {
+			constexpr auto entry_size = serialized_size_v<block_index_entry>;
+			constexpr auto footer_size = serialized_size_v<block_footer>;
+			if (size < footer_size) {
+				throw_malformed();
+			}
+			block_footer footer{};
+			deserialize_impl<block_footer, byte_order::big>(footer, data + size - footer_size);
+			if (footer.magic != block_footer::magic_number || footer.record_size != record_size ||
+				footer.records_per_block == 0 || footer.records_per_block > std::numeric_limits<uint32_t>::max() / record_size ||
+				footer.index_offset > size - footer_size ||
+				footer.block_count != (size - footer_size - footer.index_offset) / entry_size ||
+				(size - footer_size - footer.index_offset) % entry_size != 0) {
+				throw_malformed();
+			}
+
+			records_per_block_ = footer.records_per_block;
+			index_.resize(static_cast<size_t>(footer.block_count));
+			for (size_t i = 0; i < index_.size(); ++i) {
+				auto& entry = index_[i];
+				deserialize_impl<block_index_entry, byte_order::big>(entry, data + footer.index_offset + i * entry_size);
+				// All blocks except the last one are full.
+				const auto is_last = i + 1 == index_.size();
+				if (entry.record_count == 0 || entry.record_count > records_per_block_ ||
+					(!is_last && entry.record_count != records_per_block_) ||
+					entry.offset > footer.index_offset || entry.compressed_size > footer.index_offset - entry.offset) {
+					throw_malformed();
+				}
+				record_count_ += entry.record_count;
+			}
+			block_ = std::make_unique<uint8_t[]>(records_per_block_ * record_size);
+		}
+
+		/**
+		 * @brief Open the output of block_writer in a buffer.
+		 * @param buffer A buffer which has data() and size() member function. It must be alive while the reader is used.
+		 * @param codec The codec of blocks.
+		 * @throw serialization_error The output is malformed or written for other type.
+		 */
+		template <typename Buffer, typename = decltype(std::declval<const Buffer&>().data(), std::declval<const Buffer&>().size())>
+		explicit block_reader(const Buffer& buffer, Codec codec = Codec())
+			: block_reader(reinterpret_cast<const uint8_t*>(buffer.data()), buffer.size(), std::move(codec)) {}
+
+		/**
+		 * @brief Get the number of records.
+		 * @return The number of records.
+		 */
+		[[nodiscard]] size_t record_count() const noexcept {
+			return record_count_;
+		}
+
+		/**
+		 * @brief Get the number of records in a block except the last one.
+		 * @return The number of records in a block.
+		 */
+		[[nodiscard]] size_t records_per_block() const noexcept {
+			return records_per_block_;
+		}
+
+		/**
+		 * @brief Get the block index.
+		 * @return The entries of blocks.
+		 */
+		[[nodiscard]] const std::vector<block_index_entry>& index() const noexcept {
+			return index_;
+		}
+
+		/**
+		 * @brief Get serialized records in a block. The block is decompressed unless it is cached.
+		 * @param block The index of the block.
+		 * @return The pointer to serialized records, which is valid until other block is requested.
+		 * @throw std::out_of_range The index is out of range.
+		 * @throw serialization_error The block is malformed.
+		 */
+		const uint8_t* block_data(const size_t block) {
+			if (block >= index_.size()) {
+				throw std::out_of_range("The index of the block is out of range.");
+			}
+			if (block == cached_block_) {
+				return block_.get();
+			}
+
+			const auto& entry = index_[block];
+			const auto raw_size = entry.record_count * record_size;
+			const auto source = data_ + entry.offset;
+			cached_block_ = invalid_block;
+			if (entry.compressed_size == raw_size) {
+				std::memcpy(block_.get(), source, raw_size);
+			}
+			else {
+				codec_.decompress(source, entry.compressed_size, block_.get(), raw_size);
+			}
+			cached_block_ = block;
+			return block_.get();
+		}
+
+		/**
+		 * @brief Read a record.
+		 * @param index The index of the record.
+		 * @param obj A destination object.
+		 * @throw std::out_of_range The index is out of range.
+		 * @throw serialization_error The block is malformed.
+		 */
+		void read(const size_t index, T& obj) {
+			if (index >= record_count_) {
+				throw std::out_of_range("The index of the record is out of range.");
+			}
+			const auto data = block_data(index / records_per_block_);
+			deserialize_impl<T, Order>(obj, data + index % records_per_block_ * record_size);
+		}
+
+	private:
+		static constexpr size_t invalid_block = std::numeric_limits<size_t>::max();
+
+		const uint8_t* data_;
+		Codec codec_;
+		size_t records_per_block_ = 0;
+		size_t record_count_ = 0;
+		std::vector<block_index_entry> index_;
+		std::unique_ptr<uint8_t[]> block_;
+		size_t cached_block_ = invalid_block;
+
+		[[noreturn]] static void throw_malformed() {
+			throw serialization_error("Block data is malformed.");
+		}
+	};
+}
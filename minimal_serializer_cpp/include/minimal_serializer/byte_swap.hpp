@@ -0,0 +1,114 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <boost/endian/conversion.hpp>
+
+// SIMD kernels are selected in compile time by instruction sets enabled in the compiler options (e.g. -mavx2 or /arch:AVX2).
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MINIMAL_SERIALIZER_BYTE_SWAP_AVX2
+#endif
+
+#if defined(__SSSE3__) || defined(__AVX2__)
+#include <tmmintrin.h>
+#define MINIMAL_SERIALIZER_BYTE_SWAP_SSSE3
+#endif
+
+namespace minimal_serializer {
+	/**
+	 * Reverse byte order of a value with the size in unaligned memory.
+	 * @tparam Size The size of value, which must be 1, 2, 4 or 8.
+	 * @param data A pointer to the value.
+	 */
+	template <size_t Size>
+	void reverse_bytes_inplace(uint8_t* data) {
+		if constexpr (Size == 2 || Size == 4 || Size == 8) {
+			using uint_t = std::conditional_t<Size == 2, uint16_t, std::conditional_t<Size == 4, uint32_t, uint64_t>>;
+			uint_t value;
+			std::memcpy(&value, data, Size);
+			value = boost::endian::endian_reverse(value);
+			std::memcpy(data, &value, Size);
+		}
+		else {
+			static_assert(Size == 1, "Size must be 1, 2, 4 or 8.");
+		}
+	}
+
+	/**
+	 * Reverse byte order of each values in unaligned memory one by one.
+	 * @tparam Size The size of each value, which must be 1, 2, 4 or 8.
+	 * @param data A pointer to the first value.
+	 * @param count The number of values.
+	 */
+	template <size_t Size>
+	void reverse_bytes_array_inplace_scalar(uint8_t* data, const size_t count) {
+		if constexpr (Size > 1) {
+			for (size_t i = 0; i < count; ++i) {
+				reverse_bytes_inplace<Size>(data + i * Size);
+			}
+		}
+	}
+
+#ifdef MINIMAL_SERIALIZER_BYTE_SWAP_SSSE3
+	/**
+	 * A shuffle mask for 16 bytes to reverse byte order of each value with the size.
+	 */
+	template <size_t Size>
+	__m128i get_reverse_bytes_shuffle_mask_128() {
+		static_assert(Size == 2 || Size == 4 || Size == 8, "Size must be 2, 4 or 8.");
+		if constexpr (Size == 2) {
+			return _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+		}
+		else if constexpr (Size == 4) {
+			return _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+		}
+		else {
+			return _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+		}
+	}
+#endif
+
+	/**
+	 * Reverse byte order of each values in unaligned memory. SIMD instructions (AVX2 or SSSE3) are used if they are enabled in compile time.
+	 * @tparam Size The size of each value, which must be 1, 2, 4 or 8.
+	 * @param data A pointer to the first value.
+	 * @param count The number of values.
+	 */
+	template <size_t Size>
+	void reverse_bytes_array_inplace(uint8_t* data, const size_t count) {
+		static_assert(Size == 1 || Size == 2 || Size == 4 || Size == 8, "Size must be 1, 2, 4 or 8.");
+		if constexpr (Size > 1) {
+			const auto byte_size = count * Size;
+			size_t i = 0;
+#ifdef MINIMAL_SERIALIZER_BYTE_SWAP_SSSE3
+			const auto mask_128 = get_reverse_bytes_shuffle_mask_128<Size>();
+#ifdef MINIMAL_SERIALIZER_BYTE_SWAP_AVX2
+			// _mm256_shuffle_epi8 shuffles each 128 bit lane independently, so the same mask is used in both lanes.
+			const auto mask_256 = _mm256_broadcastsi128_si256(mask_128);
+			for (; i + 32 <= byte_size; i += 32) {
+				auto* ptr = reinterpret_cast<__m256i*>(data + i);
+				_mm256_storeu_si256(ptr, _mm256_shuffle_epi8(_mm256_loadu_si256(ptr), mask_256));
+			}
+#endif
+			for (; i + 16 <= byte_size; i += 16) {
+				auto* ptr = reinterpret_cast<__m128i*>(data + i);
+				_mm_storeu_si128(ptr, _mm_shuffle_epi8(_mm_loadu_si128(ptr), mask_128));
+			}
+#endif
+			reverse_bytes_array_inplace_scalar<Size>(data + i, (byte_size - i) / Size);
+		}
+	}
+}
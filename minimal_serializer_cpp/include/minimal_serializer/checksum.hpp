@@ -0,0 +1,536 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include <boost/endian/conversion.hpp>
+
+#include "serializer.hpp"
+#include "sink_source.hpp"
+
+// The hardware CRC32C kernel is selected in compile time by instruction sets enabled in the compiler options (e.g. -msse4.2 or /arch:AVX).
+#if (defined(__SSE4_2__) || defined(__AVX__)) && (defined(__x86_64__) || defined(_M_X64))
+#include <nmmintrin.h>
+#define MINIMAL_SERIALIZER_CRC32C_SSE42
+#endif
+
+namespace minimal_serializer {
+	/**
+	 * The reversed polynomial of CRC32C (Castagnoli).
+	 */
+	constexpr uint32_t crc32c_polynomial = 0x82f63b78;
+
+	constexpr std::array<std::array<uint32_t, 256>, 8> make_crc32c_tables() {
+		std::array<std::array<uint32_t, 256>, 8> tables{};
+		for (uint32_t i = 0; i < 256; ++i) {
+			auto crc = i;
+			for (int bit = 0; bit < 8; ++bit) {
+				crc = crc & 1 ? crc >> 1 ^ crc32c_polynomial : crc >> 1;
+			}
+			tables[0][i] = crc;
+		}
+		// tables[k][i] is the CRC of byte i followed by k zero bytes.
+		for (size_t k = 1; k < tables.size(); ++k) {
+			for (size_t i = 0; i < 256; ++i) {
+				tables[k][i] = tables[k - 1][i] >> 8 ^ tables[0][tables[k - 1][i] & 0xff];
+			}
+		}
+		return tables;
+	}
+
+	/**
+	 * Tables for the slicing-by-8 CRC32C algorithm.
+	 */
+	inline constexpr auto crc32c_tables = make_crc32c_tables();
+
+	/**
+	 * Multiply polynomials a and b modulo the CRC32C polynomial in the reversed bit order.
+	 */
+	constexpr uint32_t crc32c_multiply(const uint32_t a, uint32_t b) noexcept {
+		uint32_t product = 0;
+		for (uint32_t mask = uint32_t{1} << 31; mask != 0; mask >>= 1) {
+			if (a & mask) {
+				product ^= b;
+			}
+			b = b & 1 ? b >> 1 ^ crc32c_polynomial : b >> 1;
+		}
+		return product;
+	}
+
+	/**
+	 * Calculate x^(8 * size) modulo the CRC32C polynomial, which shifts a CRC register over size zero bytes by crc32c_multiply().
+	 */
+	constexpr uint32_t crc32c_zero_bytes_operator(const size_t size) noexcept {
+		// x^0 in the reversed bit order
+		uint32_t result = uint32_t{1} << 31;
+		// x^8
+		uint32_t power = uint32_t{1} << 23;
+		for (auto n = size; n != 0; n >>= 1) {
+			if (n & 1) {
+				result = crc32c_multiply(power, result);
+			}
+			power = crc32c_multiply(power, power);
+		}
+		return result;
+	}
+
+	/**
+	 * Update a raw CRC32C register with data by the slicing-by-8 algorithm. If Copy is true, data is also copied to destination in the same pass.
+	 */
+	template <bool Copy>
+	uint32_t crc32c_update_software(uint32_t crc, const uint8_t* data, size_t size, uint8_t* destination) noexcept {
+		const auto& t = crc32c_tables;
+		for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t)) {
+			uint64_t word;
+			std::memcpy(&word, data, sizeof(word));
+			if constexpr (Copy) {
+				std::memcpy(destination, &word, sizeof(word));
+				destination += sizeof(word);
+			}
+			data += sizeof(word);
+			word = boost::endian::little_to_native(word) ^ crc;
+			crc = t[7][word & 0xff] ^ t[6][word >> 8 & 0xff] ^ t[5][word >> 16 & 0xff] ^ t[4][word >> 24 & 0xff] ^
+				t[3][word >> 32 & 0xff] ^ t[2][word >> 40 & 0xff] ^ t[1][word >> 48 & 0xff] ^ t[0][word >> 56];
+		}
+		for (; size != 0; --size) {
+			if constexpr (Copy) {
+				*destination++ = *data;
+			}
+			crc = t[0][(crc ^ *data++) & 0xff] ^ crc >> 8;
+		}
+		return crc;
+	}
+
+#ifdef MINIMAL_SERIALIZER_CRC32C_SSE42
+	/**
+	 * The size of each of three streams which are calculated in parallel to hide the latency of crc32 instruction.
+	 */
+	constexpr size_t crc32c_stream_size = 256;
+
+	constexpr std::array<std::array<uint32_t, 256>, 4> make_crc32c_shift_tables(const size_t size) {
+		const auto shift = crc32c_zero_bytes_operator(size);
+		std::array<std::array<uint32_t, 256>, 4> tables{};
+		for (size_t k = 0; k < tables.size(); ++k) {
+			for (uint32_t i = 0; i < 256; ++i) {
+				tables[k][i] = crc32c_multiply(shift, i << 8 * k);
+			}
+		}
+		return tables;
+	}
+
+	/**
+	 * Tables to shift a CRC register over a stream by crc32c_multiply() byte by byte, which is possible because the multiplication is linear.
+	 */
+	inline constexpr auto crc32c_stream_shift_tables = make_crc32c_shift_tables(crc32c_stream_size);
+
+	/**
+	 * Shift a raw CRC32C register over crc32c_stream_size zero bytes.
+	 */
+	inline uint32_t crc32c_shift_stream(const uint32_t crc) noexcept {
+		const auto& t = crc32c_stream_shift_tables;
+		return t[0][crc & 0xff] ^ t[1][crc >> 8 & 0xff] ^ t[2][crc >> 16 & 0xff] ^ t[3][crc >> 24];
+	}
+
+	/**
+	 * Update a raw CRC32C register with data by the crc32 instruction of SSE4.2. If Copy is true, data is also copied to destination in the same pass.
+	 */
+	template <bool Copy>
+	uint32_t crc32c_update_sse42(uint32_t crc, const uint8_t* data, size_t size, uint8_t* destination) noexcept {
+		const auto step = [&](uint64_t crc_value, const size_t offset) {
+			uint64_t word;
+			std::memcpy(&word, data + offset, sizeof(word));
+			if constexpr (Copy) {
+				std::memcpy(destination + offset, &word, sizeof(word));
+			}
+			return _mm_crc32_u64(crc_value, word);
+		};
+
+		// Calculate three independent streams and combine them by shifting CRCs of the former streams over the latter streams.
+		for (; size >= 3 * crc32c_stream_size; size -= 3 * crc32c_stream_size) {
+			uint64_t crc0 = crc;
+			uint64_t crc1 = 0;
+			uint64_t crc2 = 0;
+			for (size_t offset = 0; offset < crc32c_stream_size; offset += sizeof(uint64_t)) {
+				crc0 = step(crc0, offset);
+				crc1 = step(crc1, crc32c_stream_size + offset);
+				crc2 = step(crc2, 2 * crc32c_stream_size + offset);
+			}
+			crc = crc32c_shift_stream(static_cast<uint32_t>(crc0)) ^ static_cast<uint32_t>(crc1);
+			crc = crc32c_shift_stream(crc) ^ static_cast<uint32_t>(crc2);
+			data += 3 * crc32c_stream_size;
+			if constexpr (Copy) {
+				destination += 3 * crc32c_stream_size;
+			}
+		}
+
+		uint64_t crc64 = crc;
+		for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t)) {
+			crc64 = step(crc64, 0);
+			data += sizeof(uint64_t);
+			if constexpr (Copy) {
+				destination += sizeof(uint64_t);
+			}
+		}
+		crc = static_cast<uint32_t>(crc64);
+		for (; size != 0; --size) {
+			if constexpr (Copy) {
+				*destination++ = *data;
+			}
+			crc = _mm_crc32_u8(crc, *data++);
+		}
+		return crc;
+	}
+#endif
+
+	template <bool Copy>
+	uint32_t crc32c_update(const uint32_t crc, const uint8_t* data, const size_t size, uint8_t* destination) noexcept {
+#ifdef MINIMAL_SERIALIZER_CRC32C_SSE42
+		return crc32c_update_sse42<Copy>(crc, data, size, destination);
+#else
+		return crc32c_update_software<Copy>(crc, data, size, destination);
+#endif
+	}
+
+	/**
+	 * @brief Calculate CRC32C of data. The SSE4.2 crc32 instruction is used if it is enabled in the compiler options, otherwise the slicing-by-8 algorithm is used.
+	 * @param data Data to calculate.
+	 * @param size The size of data.
+	 * @param crc CRC32C of preceding data to continue the calculation.
+	 * @return CRC32C of data.
+	 */
+	inline uint32_t crc32c(const uint8_t* data, const size_t size, const uint32_t crc = 0) noexcept {
+		return ~crc32c_update<false>(~crc, data, size, nullptr);
+	}
+
+	/**
+	 * @brief Copy data and calculate CRC32C of it in one pass.
+	 * @param destination A destination which has size bytes. It must not overlap with data.
+	 * @param data Data to copy and calculate.
+	 * @param size The size of data.
+	 * @param crc CRC32C of preceding data to continue the calculation.
+	 * @return CRC32C of data.
+	 */
+	inline uint32_t copy_with_crc32c(uint8_t* destination, const uint8_t* data, const size_t size,
+									const uint32_t crc = 0) noexcept {
+		return ~crc32c_update<true>(~crc, data, size, destination);
+	}
+
+	/**
+	 * The size of a checksum appended to serialized data.
+	 */
+	constexpr size_t checksum_size = sizeof(uint32_t);
+
+	/**
+	 * The size of serialized data of T followed by its CRC32C.
+	 */
+	template <typename T, byte_order Order = byte_order::big>
+	constexpr size_t checksummed_serialized_size_v = serialized_size_v<T, Order> + checksum_size;
+
+	/**
+	 * A fixed size byte array of serialized data of T followed by its CRC32C.
+	 */
+	template <typename T, byte_order Order = byte_order::big>
+	using checksummed_serialized_data = std::array<uint8_t, checksummed_serialized_size_v<T, Order>>;
+
+	/**
+	 * Update a raw CRC32C register with the object representation of a value in a register.
+	 */
+	template <typename V>
+	uint32_t crc32c_update_value(const uint32_t crc, const V& value) noexcept {
+#ifdef MINIMAL_SERIALIZER_CRC32C_SSE42
+		// The crc32 instruction reads bytes from the lowest, which is same as the memory order on x64.
+		if constexpr (sizeof(V) == sizeof(uint64_t)) {
+			uint64_t word;
+			std::memcpy(&word, &value, sizeof(word));
+			return static_cast<uint32_t>(_mm_crc32_u64(crc, word));
+		}
+		else if constexpr (sizeof(V) == sizeof(uint32_t)) {
+			uint32_t word;
+			std::memcpy(&word, &value, sizeof(word));
+			return _mm_crc32_u32(crc, word);
+		}
+		else if constexpr (sizeof(V) == sizeof(uint16_t)) {
+			uint16_t word;
+			std::memcpy(&word, &value, sizeof(word));
+			return _mm_crc32_u16(crc, word);
+		}
+		else if constexpr (sizeof(V) == sizeof(uint8_t)) {
+			uint8_t word;
+			std::memcpy(&word, &value, sizeof(word));
+			return _mm_crc32_u8(crc, word);
+		}
+#endif
+		return crc32c_update<false>(crc, reinterpret_cast<const uint8_t*>(&value), sizeof(V), nullptr);
+	}
+
+	/**
+	 * The size of chunks of arrays which are converted and then checksummed while they are in L1 cache.
+	 */
+	constexpr size_t crc32c_serialize_chunk_size = 12288;
+
+	template <typename T, byte_order Order>
+	uint32_t serialize_with_crc32c_update(const T& obj, uint8_t* data, uint32_t crc);
+
+	/**
+	 * Serialize contiguous objects back to back and update a raw CRC32C register with serialized data in the same pass.
+	 */
+	template <typename T, byte_order Order>
+	uint32_t serialize_array_with_crc32c_update(const T* objects, const size_t count, uint8_t* data, uint32_t crc) {
+		if constexpr (is_serialized_layout_compatible_v<T> && Order == byte_order::native) {
+			return crc32c_update<true>(crc, reinterpret_cast<const uint8_t*>(objects), sizeof(T) * count, data);
+		}
+		else if constexpr (is_serializable_builtin_type_v<T> || is_serializable_enum_v<T>) {
+			// Convert endian of a chunk in bulk and calculate the checksum of it right after it is stored.
+			constexpr auto chunk_count = crc32c_serialize_chunk_size / sizeof(T);
+			for (size_t i = 0; i < count; i += chunk_count) {
+				const auto n = std::min(chunk_count, count - i);
+				serialize_array_impl<T, Order>(objects + i, n, data + i * sizeof(T));
+				crc = crc32c_update<false>(crc, data + i * sizeof(T), n * sizeof(T), nullptr);
+			}
+			return crc;
+		}
+		else {
+			constexpr auto size = serialized_size_v<T, Order>;
+			for (size_t i = 0; i < count; ++i) {
+				crc = serialize_with_crc32c_update<T, Order>(objects[i], data + i * size, crc);
+			}
+			return crc;
+		}
+	}
+
+	template <typename T, byte_order Order, size_t... Is>
+	uint32_t serialize_tuple_with_crc32c_update(const T& obj, uint8_t* data, uint32_t crc, std::index_sequence<Is...>) {
+		// Serialized elements are contiguous in the order, so the checksum is updated element by element.
+		((crc = serialize_with_crc32c_update<remove_cvref_t<std::tuple_element_t<Is, T>>, Order>(
+			std::get<Is>(obj), data + serialized_tuple_offsets_v<T>[Is], crc)), ...);
+		return crc;
+	}
+
+	/**
+	 * Serialize data to the position which is already checked to have enough space and update a raw CRC32C register with serialized data in the same pass.
+	 */
+	template <typename T, byte_order Order>
+	uint32_t serialize_with_crc32c_update(const T& obj, uint8_t* data, const uint32_t crc) {
+		if constexpr (is_serialized_layout_compatible_v<T> && Order == byte_order::native) {
+			// The memory layout is same as serialized data, so the checksum is calculated while copying.
+			return crc32c_update<true>(crc, reinterpret_cast<const uint8_t*>(&obj), sizeof(T), data);
+		}
+		else if constexpr (is_serializable_builtin_type_v<T>) {
+			// Calculate the checksum of the converted value in the register.
+			auto e_value = obj;
+			convert_endian_native_to_inplace<Order>(e_value);
+			std::memcpy(data, &e_value, sizeof(T));
+			return crc32c_update_value(crc, e_value);
+		}
+		else if constexpr (is_serializable_enum_v<T>) {
+			using underlying_type = std::underlying_type_t<T>;
+			return serialize_with_crc32c_update<underlying_type, Order>(static_cast<underlying_type>(obj), data, crc);
+		}
+		else if constexpr (is_std_array_v<T>) {
+			return serialize_array_with_crc32c_update<typename T::value_type, Order>(obj.data(), obj.size(), data, crc);
+		}
+		else if constexpr (is_serializable_tuple_v<T>) {
+			return serialize_tuple_with_crc32c_update<T, Order>(obj, data, crc, std::make_index_sequence<std::tuple_size_v<T>>{});
+		}
+		else if constexpr (is_serializable_custom_type_v<T> && !is_bit_packed_v<T>) {
+			using target_types = typename serialize_targets_t<T>::const_reference_types;
+			const auto target_references = serialize_targets_t<T>::get_const_reference_tuple(obj);
+			return serialize_tuple_with_crc32c_update<target_types, Order>(
+				target_references, data, crc, std::make_index_sequence<std::tuple_size_v<target_types>>{});
+		}
+		else {
+			// Strings and bit packed types are written byte by byte or bit by bit, so the checksum is calculated right after each of them is written.
+			serialize_impl<T, Order>(obj, data);
+			return crc32c_update<false>(crc, data, serialized_size_v<T, Order>, nullptr);
+		}
+	}
+
+	/**
+	 * Serialize data followed by its CRC32C in Order to the position which is already checked to have enough space.
+	 */
+	template <typename T, byte_order Order>
+	void serialize_checksummed_impl(const T& obj, uint8_t* data) {
+		const auto crc = ~serialize_with_crc32c_update<T, Order>(obj, data, ~uint32_t{0});
+		serialize_impl<uint32_t, Order>(crc, data + serialized_size_v<T, Order>);
+	}
+
+	/**
+	 * Check the CRC32C of serialized data at the position which is already checked to have enough space.
+	 */
+	template <typename T, byte_order Order>
+	bool is_checksum_valid_impl(const uint8_t* data) noexcept {
+		constexpr auto size = serialized_size_v<T, Order>;
+		uint32_t crc;
+		deserialize_impl<uint32_t, Order>(crc, data + size);
+		return crc32c(data, size) == crc;
+	}
+
+	/**
+	 * Serialize data followed by its CRC32C to size fixed byte array.
+	 * The checksum is calculated while serializing, from converted values in registers or chunks of arrays in L1 cache.
+	 *
+	 * @param obj A object to serialize.
+	 * @tparam Order The byte order of serialized data and the checksum.
+	 * @tparam T The type of data to serialize.
+	 * @return Serialized data followed by the checksum.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <byte_order Order, typename T>
+	checksummed_serialized_data<T, Order> serialize_checksummed(const T& obj) {
+		checksummed_serialized_data<T, Order> data;
+		serialize_checksummed_impl<T, Order>(obj, data.data());
+		return data;
+	}
+
+	/**
+	 * Serialize data followed by its CRC32C to size fixed byte array in big endian.
+	 * The checksum is calculated while serializing, from converted values in registers or chunks of arrays in L1 cache.
+	 *
+	 * @param obj A object to serialize.
+	 * @tparam T The type of data to serialize.
+	 * @return Serialized data followed by the checksum.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <typename T>
+	checksummed_serialized_data<T> serialize_checksummed(const T& obj) {
+		return serialize_checksummed<byte_order::big>(obj);
+	}
+
+	/**
+	 * Serialize data followed by its CRC32C to buffer.
+	 * The checksum is calculated while serializing, from converted values in registers or chunks of arrays in L1 cache.
+	 *
+	 * @param obj A object to serialize.
+	 * @param buffer A destination buffer which has data() and size() member function.
+	 * @param offset A start position of the buffer.
+	 * @tparam Order The byte order of serialized data and the checksum.
+	 * @tparam T The type of data to serialize.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <byte_order Order, typename T, typename Buffer>
+	auto serialize_checksummed(const T& obj, Buffer& buffer, const size_t offset = 0) -> decltype(
+		std::declval<Buffer>().data(), std::declval<Buffer>().size(), void()) {
+		if (offset > buffer.size() || buffer.size() - offset < checksummed_serialized_size_v<T, Order>) {
+			throw serialization_error("Serialization source is out of range.");
+		}
+		serialize_checksummed_impl<T, Order>(obj, buffer.data() + offset);
+	}
+
+	/**
+	 * Serialize data followed by its CRC32C to buffer in big endian.
+	 * The checksum is calculated while serializing, from converted values in registers or chunks of arrays in L1 cache.
+	 *
+	 * @param obj A object to serialize.
+	 * @param buffer A destination buffer which has data() and size() member function.
+	 * @param offset A start position of the buffer.
+	 * @tparam T The type of data to serialize.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <typename T, typename Buffer>
+	auto serialize_checksummed(const T& obj, Buffer& buffer, const size_t offset = 0) -> decltype(
+		std::declval<Buffer>().data(), std::declval<Buffer>().size(), void()) {
+		serialize_checksummed<byte_order::big>(obj, buffer, offset);
+	}
+
+	/**
+	 * Serialize data followed by its CRC32C to sink.
+	 * The checksum is calculated while serializing, from converted values in registers or chunks of arrays in L1 cache.
+	 *
+	 * @param obj A object to serialize.
+	 * @param sink A destination sink which satisfies is_serialization_sink_v.
+	 * @tparam Order The byte order of serialized data and the checksum.
+	 * @tparam T The type of data to serialize.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <byte_order Order, typename T, typename Sink>
+	auto serialize_checksummed(const T& obj, Sink& sink) -> std::enable_if_t<is_serialization_sink_v<Sink>> {
+		constexpr auto size = checksummed_serialized_size_v<T, Order>;
+		const auto data = sink.reserve(size);
+		if (data == nullptr) {
+			throw serialization_error("Serialization source is out of range.");
+		}
+		serialize_checksummed_impl<T, Order>(obj, data);
+		sink.commit(size);
+	}
+
+	/**
+	 * Serialize data followed by its CRC32C to sink in big endian.
+	 * The checksum is calculated while serializing, from converted values in registers or chunks of arrays in L1 cache.
+	 *
+	 * @param obj A object to serialize.
+	 * @param sink A destination sink which satisfies is_serialization_sink_v.
+	 * @tparam T The type of data to serialize.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <typename T, typename Sink>
+	auto serialize_checksummed(const T& obj, Sink& sink) -> std::enable_if_t<is_serialization_sink_v<Sink>> {
+		serialize_checksummed<byte_order::big>(obj, sink);
+	}
+
+	/**
+	 * Check the CRC32C of serialized data in buffer without deserialization.
+	 *
+	 * @param buffer A source buffer which has data() and size() member function.
+	 * @param offset A start position of the buffer.
+	 * @tparam T The type of serialized data.
+	 * @tparam Order The byte order of serialized data and the checksum.
+	 * @return Whether the checksum matches.
+	 * @throw serialization_error The buffer is too small.
+	 */
+	template <typename T, byte_order Order = byte_order::big, typename Buffer>
+	auto is_checksum_valid(const Buffer& buffer, const size_t offset = 0) -> decltype(
+		std::declval<Buffer>().data(), std::declval<Buffer>().size(), bool()) {
+		if (offset > buffer.size() || buffer.size() - offset < checksummed_serialized_size_v<T, Order>) {
+			throw serialization_error("Deserialization destination is out of range.");
+		}
+		return is_checksum_valid_impl<T, Order>(reinterpret_cast<const uint8_t*>(buffer.data()) + offset);
+	}
+
+	/**
+	 * Deserialize data followed by its CRC32C from buffer. The checksum is verified before deserialization, so obj is not changed if it does not match.
+	 *
+	 * @param obj A object to deserialize.
+	 * @param buffer A source buffer which has data() and size() member function.
+	 * @param offset A start position of the buffer.
+	 * @tparam Order The byte order of serialized data and the checksum.
+	 * @tparam T The type of data to deserialize.
+	 * @throw serialization_error Deserialization is failed or the checksum does not match.
+	 */
+	template <byte_order Order, typename T, typename Buffer>
+	auto deserialize_checksummed(T& obj, const Buffer& buffer, const size_t offset = 0) -> decltype(
+		std::declval<Buffer>().data(), std::declval<Buffer>().size(), std::enable_if_t<!std::is_const_v<T>, void>()) {
+		if (!is_checksum_valid<T, Order>(buffer, offset)) {
+			throw serialization_error("Checksum of serialized data does not match.");
+		}
+		deserialize_impl<T, Order>(obj, reinterpret_cast<const uint8_t*>(buffer.data()) + offset);
+	}
+
+	/**
+	 * Deserialize data followed by its CRC32C from buffer in big endian. The checksum is verified before deserialization, so obj is not changed if it does not match.
+	 *
+	 * @param obj A object to deserialize.
+	 * @param buffer A source buffer which has data() and size() member function.
+	 * @param offset A start position of the buffer.
+	 * @tparam T The type of data to deserialize.
+	 * @throw serialization_error Deserialization is failed or the checksum does not match.
+	 */
+	template <typename T, typename Buffer>
+	auto deserialize_checksummed(T& obj, const Buffer& buffer, const size_t offset = 0) -> decltype(
+		std::declval<Buffer>().data(), std::declval<Buffer>().size(), std::enable_if_t<!std::is_const_v<T>, void>()) {
+		deserialize_checksummed<byte_order::big>(obj, buffer, offset);
+	}
+}
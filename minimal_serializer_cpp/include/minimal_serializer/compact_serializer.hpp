@@ -0,0 +1,609 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "serializer.hpp"
+#include "sink_source.hpp"
+
+// The SIMD group varint decoder is selected in compile time by instruction sets enabled in the compiler options (e.g. -mssse3 or /arch:AVX2).
+#if defined(__SSSE3__) || defined(__AVX2__)
+#include <tmmintrin.h>
+#define MINIMAL_SERIALIZER_GROUP_VARINT_SSSE3
+#endif
+
+namespace minimal_serializer {
+	/**
+	 * Whether the type is encoded as a varint in the compact format. Integers wider than one byte are varints, and signed ones are zigzag encoded before that.
+	 */
+	template <typename T>
+	constexpr bool is_compact_varint_type_v = std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) > 1;
+
+	/**
+	 * Whether std::array of the type is encoded in the group varint format in the compact format.
+	 */
+	template <typename T>
+	constexpr bool is_compact_group_varint_type_v = is_compact_varint_type_v<T> && sizeof(T) == 4;
+
+	/**
+	 * The maximum size of a varint for an integer type.
+	 */
+	template <typename T>
+	constexpr size_t varint_max_size_v = (sizeof(T) * 8 + 6) / 7;
+
+	/**
+	 * Get the size of a varint of a value.
+	 */
+	constexpr size_t get_varint_size(uint64_t value) noexcept {
+		size_t size = 1;
+		for (; value >= 0x80; value >>= 7) {
+			++size;
+		}
+		return size;
+	}
+
+	/**
+	 * Convert an integer to unsigned one so that values close to zero are small. Signed integers are zigzag encoded.
+	 */
+	template <typename T>
+	constexpr std::make_unsigned_t<T> encode_zigzag(const T value) noexcept {
+		using unsigned_type = std::make_unsigned_t<T>;
+		if constexpr (std::is_signed_v<T>) {
+			return static_cast<unsigned_type>(static_cast<unsigned_type>(value) << 1) ^
+				static_cast<unsigned_type>(value < 0 ? ~unsigned_type{0} : unsigned_type{0});
+		}
+		else {
+			return value;
+		}
+	}
+
+	/**
+	 * Convert an unsigned integer encoded by encode_zigzag() to original one.
+	 */
+	template <typename T>
+	constexpr T decode_zigzag(const std::make_unsigned_t<T> value) noexcept {
+		using unsigned_type = std::make_unsigned_t<T>;
+		if constexpr (std::is_signed_v<T>) {
+			return static_cast<T>(static_cast<unsigned_type>(value >> 1) ^ static_cast<unsigned_type>(0 - (value & 1)));
+		}
+		else {
+			return value;
+		}
+	}
+
+	/**
+	 * Write a varint to the position which has enough space.
+	 * @return The position after the varint.
+	 */
+	inline uint8_t* write_varint(uint64_t value, uint8_t* data) noexcept {
+		for (; value >= 0x80; value >>= 7) {
+			*data++ = static_cast<uint8_t>(value | 0x80);
+		}
+		*data++ = static_cast<uint8_t>(value);
+		return data;
+	}
+
+	/**
+	 * Read a varint of an unsigned integer type from the range [data, end).
+	 * @return The position after the varint.
+	 * @throw serialization_error The varint is truncated or too large for the type.
+	 */
+	template <typename T>
+	const uint8_t* read_varint(T& value, const uint8_t* data, const uint8_t* end) {
+		static_assert(std::is_unsigned_v<T>, "T must be an unsigned integer type.");
+		constexpr auto max_size = varint_max_size_v<T>;
+		// The last byte of the longest varint has only the remaining bits.
+		constexpr auto last_byte_limit = 1u << (sizeof(T) * 8 - (max_size - 1) * 7);
+		T result = 0;
+		for (size_t i = 0; i < max_size; ++i) {
+			if (data == end) {
+				throw serialization_error("Deserialization destination is out of range.");
+			}
+			const auto byte = *data++;
+			if (i == max_size - 1 && byte >= last_byte_limit) {
+				break;
+			}
+			result |= static_cast<T>(static_cast<T>(byte & 0x7f) << (i * 7));
+			if (byte < 0x80) {
+				value = result;
+				return data;
+			}
+		}
+		throw serialization_error("Compact serialized data is malformed.");
+	}
+
+	/**
+	 * The maximum size of group varint data of integers. Each group of four integers has a control byte and 1 to 4 bytes for each integer.
+	 */
+	constexpr size_t get_group_varint_max_size(const size_t count) noexcept {
+		return (count + 3) / 4 + count * 4;
+	}
+
+	constexpr size_t get_group_varint_value_size(const uint32_t value) noexcept {
+		return value < 0x100 ? 1 : value < 0x10000 ? 2 : value < 0x1000000 ? 3 : 4;
+	}
+
+	/**
+	 * Get the size of group varint data of 32 bit integers.
+	 */
+	template <typename T>
+	size_t get_group_varint_size(const T* values, const size_t count) noexcept {
+		auto size = (count + 3) / 4;
+		for (size_t i = 0; i < count; ++i) {
+			size += get_group_varint_value_size(encode_zigzag(values[i]));
+		}
+		return size;
+	}
+
+	/**
+	 * Write 32 bit integers in the group varint format to the position which has enough space. Signed integers are zigzag encoded.
+	 * Values in a group are little endian and their sizes minus one are in the control byte from the lowest bits. Bits for missing values in the last group are zero.
+	 * @return The position after the data.
+	 */
+	template <typename T>
+	uint8_t* write_group_varint(const T* values, const size_t count, uint8_t* data) noexcept {
+		static_assert(is_compact_group_varint_type_v<T>, "T must be a 32 bit integer type.");
+		for (size_t i = 0; i < count; i += 4) {
+			auto* control = data++;
+			*control = 0;
+			const auto group_size = std::min<size_t>(count - i, 4);
+			for (size_t j = 0; j < group_size; ++j) {
+				const auto value = static_cast<uint32_t>(encode_zigzag(values[i + j]));
+				const auto size = get_group_varint_value_size(value);
+				*control |= static_cast<uint8_t>((size - 1) << (j * 2));
+				for (size_t k = 0; k < size; ++k) {
+					*data++ = static_cast<uint8_t>(value >> (k * 8));
+				}
+			}
+		}
+		return data;
+	}
+
+	template <size_t... Is>
+	constexpr std::array<uint8_t, 256> make_group_varint_size_table(std::index_sequence<Is...>) {
+		return {static_cast<uint8_t>((Is & 3) + (Is >> 2 & 3) + (Is >> 4 & 3) + (Is >> 6 & 3) + 4)...};
+	}
+
+	/**
+	 * The size of data of a full group for each control byte.
+	 */
+	inline constexpr auto group_varint_size_table = make_group_varint_size_table(std::make_index_sequence<256>{});
+
+#ifdef MINIMAL_SERIALIZER_GROUP_VARINT_SSSE3
+	constexpr std::array<uint8_t, 16> make_group_varint_shuffle_mask(const size_t control) {
+		std::array<uint8_t, 16> mask{};
+		size_t source = 0;
+		for (size_t i = 0; i < 4; ++i) {
+			const auto size = (control >> (i * 2) & 3) + 1;
+			for (size_t j = 0; j < 4; ++j) {
+				// The highest bit of a shuffle mask makes the byte zero.
+				mask[i * 4 + j] = j < size ? static_cast<uint8_t>(source + j) : 0x80;
+			}
+			source += size;
+		}
+		return mask;
+	}
+
+	template <size_t... Is>
+	constexpr std::array<std::array<uint8_t, 16>, 256> make_group_varint_shuffle_table(std::index_sequence<Is...>) {
+		return {make_group_varint_shuffle_mask(Is)...};
+	}
+
+	/**
+	 * Shuffle masks which expand data of a full group to four 32 bit integers for each control byte.
+	 */
+	alignas(16) inline constexpr auto group_varint_shuffle_table = make_group_varint_shuffle_table(
+		std::make_index_sequence<256>{});
+#endif
+
+	/**
+	 * Read 32 bit integers in the group varint format from the range [data, end). SSSE3 instructions are used for full groups if they are enabled in compile time.
+	 * @return The position after the data.
+	 * @throw serialization_error The data is truncated.
+	 */
+	template <typename T>
+	const uint8_t* read_group_varint(T* values, const size_t count, const uint8_t* data, const uint8_t* end) {
+		static_assert(is_compact_group_varint_type_v<T>, "T must be a 32 bit integer type.");
+		size_t i = 0;
+#ifdef MINIMAL_SERIALIZER_GROUP_VARINT_SSSE3
+		// Each iteration loads 16 bytes after the control byte regardless of the size of the group, so stop before the end.
+		for (; i + 4 <= count && end - data >= 17; i += 4) {
+			const auto control = *data;
+			const auto mask = _mm_load_si128(reinterpret_cast<const __m128i*>(group_varint_shuffle_table[control].data()));
+			auto result = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 1)), mask);
+			if constexpr (std::is_signed_v<T>) {
+				const auto sign = _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(result, _mm_set1_epi32(1)));
+				result = _mm_xor_si128(_mm_srli_epi32(result, 1), sign);
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(values + i), result);
+			data += 1 + group_varint_size_table[control];
+		}
+#endif
+		for (; i < count; i += 4) {
+			if (data == end) {
+				throw serialization_error("Deserialization destination is out of range.");
+			}
+			const auto control = *data++;
+			const auto group_size = std::min<size_t>(count - i, 4);
+			for (size_t j = 0; j < group_size; ++j) {
+				const auto size = static_cast<size_t>((control >> (j * 2) & 3) + 1);
+				if (static_cast<size_t>(end - data) < size) {
+					throw serialization_error("Deserialization destination is out of range.");
+				}
+				uint32_t value = 0;
+				for (size_t k = 0; k < size; ++k) {
+					value |= static_cast<uint32_t>(*data++) << (k * 8);
+				}
+				values[i + j] = decode_zigzag<T>(value);
+			}
+		}
+		return data;
+	}
+
+	template <typename T>
+	constexpr size_t get_compact_serialized_max_size_impl();
+
+	template <typename T, size_t... Is>
+	constexpr size_t get_compact_serialized_max_size_tuple_impl(std::index_sequence<Is...>) {
+		return (get_compact_serialized_max_size_impl<remove_cvref_t<std::tuple_element_t<Is, T>>>() + ...);
+	}
+
+	template <typename T>
+	constexpr size_t get_compact_serialized_max_size_impl() {
+		if constexpr (is_compact_varint_type_v<T>) {
+			return varint_max_size_v<T>;
+		}
+		else if constexpr (is_serializable_builtin_type_v<T>) {
+			return sizeof(T);
+		}
+		else if constexpr (is_serializable_enum_v<T>) {
+			return get_compact_serialized_max_size_impl<std::underlying_type_t<T>>();
+		}
+		else if constexpr (is_std_array_v<T>) {
+			using element_type = typename T::value_type;
+			constexpr auto count = std::tuple_size_v<T>;
+			if constexpr (is_compact_group_varint_type_v<element_type>) {
+				return get_group_varint_max_size(count);
+			}
+			else {
+				return get_compact_serialized_max_size_impl<element_type>() * count;
+			}
+		}
+		else if constexpr (is_serializable_tuple_v<T>) {
+			return get_compact_serialized_max_size_tuple_impl<T>(std::make_index_sequence<std::tuple_size_v<T>>{});
+		}
+		else if constexpr (is_serializable_boost_static_string_v<T>) {
+			return get_varint_size(T::static_capacity) + T::static_capacity;
+		}
+		else if constexpr (is_serializable_custom_type_v<T>) {
+			using target_types = typename serialize_targets_t<T>::types;
+			return get_compact_serialized_max_size_tuple_impl<target_types>(
+				std::make_index_sequence<std::tuple_size_v<target_types>>{});
+		}
+		else {
+			static_assertion_for_not_serializable_type<T>();
+			return 0;
+		}
+	}
+
+	/**
+	 * The maximum size of serialized data of T in the compact format. If T has const, volatile and/or reference, they will be removed.
+	 */
+	template <typename T>
+	constexpr size_t compact_serialized_max_size_v = get_compact_serialized_max_size_impl<remove_cvref_t<T>>();
+
+	/**
+	 * A fixed size byte array which can store serialized data of T in the compact format.
+	 */
+	template <typename T>
+	using compact_serialized_data = std::array<uint8_t, compact_serialized_max_size_v<T>>;
+
+	template <typename T>
+	size_t get_compact_serialized_size_impl(const T& obj);
+
+	template <typename T, size_t... Is>
+	size_t get_compact_serialized_size_tuple_impl(const T& obj, std::index_sequence<Is...>) {
+		return (get_compact_serialized_size_impl<remove_cvref_t<std::tuple_element_t<Is, T>>>(std::get<Is>(obj)) + ...
+			+ 0);
+	}
+
+	template <typename T>
+	size_t get_compact_serialized_size_impl(const T& obj) {
+		if constexpr (compact_serialized_max_size_v<T> == serialized_size_v<T>) {
+			// Types which have no varint are always same size.
+			return serialized_size_v<T>;
+		}
+		else if constexpr (is_compact_varint_type_v<T>) {
+			return get_varint_size(encode_zigzag(obj));
+		}
+		else if constexpr (is_serializable_enum_v<T>) {
+			using underlying_type = std::underlying_type_t<T>;
+			return get_compact_serialized_size_impl<underlying_type>(static_cast<underlying_type>(obj));
+		}
+		else if constexpr (is_std_array_v<T>) {
+			using element_type = typename T::value_type;
+			if constexpr (is_compact_group_varint_type_v<element_type>) {
+				return get_group_varint_size(obj.data(), obj.size());
+			}
+			else {
+				size_t size = 0;
+				for (const auto& element : obj) {
+					size += get_compact_serialized_size_impl<element_type>(element);
+				}
+				return size;
+			}
+		}
+		else if constexpr (is_serializable_tuple_v<T>) {
+			return get_compact_serialized_size_tuple_impl<T>(obj, std::make_index_sequence<std::tuple_size_v<T>>{});
+		}
+		else if constexpr (is_serializable_boost_static_string_v<T>) {
+			return get_varint_size(obj.size()) + obj.size();
+		}
+		else if constexpr (is_serializable_custom_type_v<T>) {
+			using target_types = typename serialize_targets_t<T>::const_reference_types;
+			return get_compact_serialized_size_tuple_impl<target_types>(
+				serialize_targets_t<T>::get_const_reference_tuple(obj),
+				std::make_index_sequence<std::tuple_size_v<target_types>>{});
+		}
+		else {
+			return raise_error_for_not_serializable_type<T, size_t>();
+		}
+	}
+
+	/**
+	 * Get the actual size of serialized data of an object in the compact format.
+	 *
+	 * @param obj A object to serialize.
+	 * @return The size of serialized data.
+	 */
+	template <typename T>
+	size_t compact_serialized_size(const T& obj) {
+		return get_compact_serialized_size_impl<remove_cvref_t<T>>(obj);
+	}
+
+	template <typename T>
+	uint8_t* serialize_compact_impl(const T& obj, uint8_t* data);
+
+	template <typename T, size_t... Is>
+	uint8_t* serialize_compact_tuple_impl(const T& obj, uint8_t* data, std::index_sequence<Is...>) {
+		((data = serialize_compact_impl<remove_cvref_t<std::tuple_element_t<Is, T>>>(std::get<Is>(obj), data)), ...);
+		return data;
+	}
+
+	/**
+	 * Serialize data in the compact format to the position which is already checked to have enough space.
+	 * @return The position after the serialized data.
+	 */
+	template <typename T>
+	uint8_t* serialize_compact_impl(const T& obj, uint8_t* data) {
+		if constexpr (is_compact_varint_type_v<T>) {
+			return write_varint(encode_zigzag(obj), data);
+		}
+		else if constexpr (is_serializable_builtin_type_v<T>) {
+			// Fixed size values such as floating point numbers are little endian like varints.
+			serialize_impl<T, byte_order::little>(obj, data);
+			return data + sizeof(T);
+		}
+		else if constexpr (is_serializable_enum_v<T>) {
+			using underlying_type = std::underlying_type_t<T>;
+			return serialize_compact_impl<underlying_type>(static_cast<underlying_type>(obj), data);
+		}
+		else if constexpr (is_std_array_v<T>) {
+			using element_type = typename T::value_type;
+			if constexpr (is_compact_group_varint_type_v<element_type>) {
+				return write_group_varint(obj.data(), obj.size(), data);
+			}
+			else if constexpr (compact_serialized_max_size_v<element_type> == serialized_size_v<element_type>) {
+				constexpr auto size = serialized_size_v<T>;
+				serialize_array_impl<element_type, byte_order::little>(obj.data(), obj.size(), data);
+				return data + size;
+			}
+			else {
+				for (const auto& element : obj) {
+					data = serialize_compact_impl<element_type>(element, data);
+				}
+				return data;
+			}
+		}
+		else if constexpr (is_serializable_tuple_v<T>) {
+			return serialize_compact_tuple_impl<T>(obj, data, std::make_index_sequence<std::tuple_size_v<T>>{});
+		}
+		else if constexpr (is_serializable_boost_static_string_v<T>) {
+			data = write_varint(obj.size(), data);
+			obj.copy(reinterpret_cast<typename T::value_type*>(data), obj.size());
+			return data + obj.size();
+		}
+		else if constexpr (is_serializable_custom_type_v<T>) {
+			using target_types = typename serialize_targets_t<T>::const_reference_types;
+			return serialize_compact_tuple_impl<target_types>(serialize_targets_t<T>::get_const_reference_tuple(obj), data,
+															std::make_index_sequence<std::tuple_size_v<target_types>>{});
+		}
+		else {
+			return raise_error_for_not_serializable_type<T, uint8_t*>();
+		}
+	}
+
+	template <typename T>
+	const uint8_t* deserialize_compact_impl(T& obj, const uint8_t* data, const uint8_t* end);
+
+	template <typename T, size_t... Is>
+	const uint8_t* deserialize_compact_tuple_impl(T& obj, const uint8_t* data, const uint8_t* end,
+												std::index_sequence<Is...>) {
+		((data = deserialize_compact_impl<remove_cvref_t<std::tuple_element_t<Is, T>>>(std::get<Is>(obj), data, end)),
+			...);
+		return data;
+	}
+
+	/**
+	 * Deserialize data in the compact format from the range [data, end).
+	 * @return The position after the serialized data.
+	 */
+	template <typename T>
+	const uint8_t* deserialize_compact_impl(T& obj, const uint8_t* data, const uint8_t* end) {
+		if constexpr (is_compact_varint_type_v<T>) {
+			std::make_unsigned_t<T> value;
+			data = read_varint(value, data, end);
+			obj = decode_zigzag<T>(value);
+			return data;
+		}
+		else if constexpr (is_serializable_builtin_type_v<T>) {
+			if (static_cast<size_t>(end - data) < sizeof(T)) {
+				throw serialization_error("Deserialization destination is out of range.");
+			}
+			deserialize_impl<T, byte_order::little>(obj, data);
+			return data + sizeof(T);
+		}
+		else if constexpr (is_serializable_enum_v<T>) {
+			using underlying_type = std::underlying_type_t<T>;
+			// In order to cast with referencing same value, cast via pointer.
+			return deserialize_compact_impl<underlying_type>(*reinterpret_cast<underlying_type*>(&obj), data, end);
+		}
+		else if constexpr (is_std_array_v<T>) {
+			using element_type = typename T::value_type;
+			if constexpr (is_compact_group_varint_type_v<element_type>) {
+				return read_group_varint(obj.data(), obj.size(), data, end);
+			}
+			else if constexpr (compact_serialized_max_size_v<element_type> == serialized_size_v<element_type>) {
+				constexpr auto size = serialized_size_v<T>;
+				if (static_cast<size_t>(end - data) < size) {
+					throw serialization_error("Deserialization destination is out of range.");
+				}
+				deserialize_array_impl<element_type, byte_order::little>(obj.data(), obj.size(), data);
+				return data + size;
+			}
+			else {
+				for (auto& element : obj) {
+					data = deserialize_compact_impl<element_type>(element, data, end);
+				}
+				return data;
+			}
+		}
+		else if constexpr (is_serializable_tuple_v<T>) {
+			return deserialize_compact_tuple_impl<T>(obj, data, end, std::make_index_sequence<std::tuple_size_v<T>>{});
+		}
+		else if constexpr (is_serializable_boost_static_string_v<T>) {
+			size_t size;
+			data = read_varint(size, data, end);
+			if (size > T::static_capacity) {
+				throw serialization_error("Compact serialized data is malformed.");
+			}
+			if (static_cast<size_t>(end - data) < size) {
+				throw serialization_error("Deserialization destination is out of range.");
+			}
+			obj.assign(reinterpret_cast<const typename T::value_type*>(data), size);
+			return data + size;
+		}
+		else if constexpr (is_serializable_custom_type_v<T>) {
+			using target_types = typename serialize_targets_t<T>::reference_types;
+			auto target_references = serialize_targets_t<T>::get_reference_tuple(obj);
+			return deserialize_compact_tuple_impl<target_types>(target_references, data, end,
+																std::make_index_sequence<std::tuple_size_v<target_types>>{});
+		}
+		else {
+			return raise_error_for_not_serializable_type<T, const uint8_t*>();
+		}
+	}
+
+	/**
+	 * Serialize data in the compact format to size fixed byte array which has enough space for any value.
+	 *
+	 * @param obj A object to serialize.
+	 * @tparam T The type of data to serialize.
+	 * @return A pair of a byte array and the size of serialized data in it.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <typename T>
+	std::pair<compact_serialized_data<T>, size_t> serialize_compact(const T& obj) {
+		std::pair<compact_serialized_data<T>, size_t> result;
+		result.second = static_cast<size_t>(serialize_compact_impl<T>(obj, result.first.data()) - result.first.data());
+		return result;
+	}
+
+	/**
+	 * Serialize data in the compact format to buffer.
+	 *
+	 * @param obj A object to serialize.
+	 * @param buffer A destination buffer which has data() and size() member function.
+	 * @param offset A start position of the buffer.
+	 * @tparam T The type of data to serialize.
+	 * @return The size of serialized data.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <typename T, typename Buffer>
+	auto serialize_compact(const T& obj, Buffer& buffer, const size_t offset = 0) -> decltype(
+		std::declval<Buffer>().data(), std::declval<Buffer>().size(), size_t()) {
+		if (offset > buffer.size()) {
+			throw serialization_error("Serialization source is out of range.");
+		}
+		// Calculate the actual size only when the buffer may be too small for the maximum size.
+		if (buffer.size() - offset < compact_serialized_max_size_v<T> &&
+			buffer.size() - offset < compact_serialized_size(obj)) {
+			throw serialization_error("Serialization source is out of range.");
+		}
+
+		const auto data = buffer.data() + offset;
+		return static_cast<size_t>(serialize_compact_impl<T>(obj, data) - data);
+	}
+
+	/**
+	 * Serialize data in the compact format to sink.
+	 * The maximum size is reserved first and only the actual size is committed. If the sink cannot reserve the maximum size, the actual size is reserved.
+	 *
+	 * @param obj A object to serialize.
+	 * @param sink A destination sink which satisfies is_serialization_sink_v.
+	 * @tparam T The type of data to serialize.
+	 * @return The size of serialized data.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <typename T, typename Sink>
+	auto serialize_compact(const T& obj, Sink& sink) -> std::enable_if_t<is_serialization_sink_v<Sink>, size_t> {
+		auto data = sink.reserve(compact_serialized_max_size_v<T>);
+		if (data == nullptr) {
+			data = sink.reserve(compact_serialized_size(obj));
+			if (data == nullptr) {
+				throw serialization_error("Serialization source is out of range.");
+			}
+		}
+
+		const auto size = static_cast<size_t>(serialize_compact_impl<T>(obj, data) - data);
+		sink.commit(size);
+		return size;
+	}
+
+	/**
+	 * Deserialize data in the compact format from buffer.
+	 *
+	 * @param obj A object to deserialize.
+	 * @param buffer A source buffer which has data() and size() member function.
+	 * @param offset A start position of the buffer.
+	 * @tparam T The type of data to deserialize.
+	 * @return The size of read serialized data.
+	 * @throw serialization_error Deserialization is failed or the data is malformed.
+	 */
+	template <typename T, typename Buffer>
+	auto deserialize_compact(T& obj, const Buffer& buffer, const size_t offset = 0) -> decltype(
+		std::declval<Buffer>().data(), std::declval<Buffer>().size(), std::enable_if_t<!std::is_const_v<T>, size_t>()) {
+		if (offset > buffer.size()) {
+			throw serialization_error("Deserialization destination is out of range.");
+		}
+
+		const auto data = buffer.data() + offset;
+		const auto end = buffer.data() + buffer.size();
+		return static_cast<size_t>(deserialize_compact_impl<T>(obj, data, end) - data);
+	}
+}
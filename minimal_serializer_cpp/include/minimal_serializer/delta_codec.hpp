@@ -0,0 +1,385 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "compact_serializer.hpp"
+#include "serializer.hpp"
+#include "sink_source.hpp"
+
+namespace minimal_serializer {
+	/**
+	 * The method to calculate a delta between serialized data of consecutive records.
+	 */
+	enum class delta_method : uint8_t {
+		// XOR of each byte. This is the fastest and suitable for fields which change rarely.
+		xor_bytes,
+		// Difference of each arithmetic value such as integers in serialized data. This is suitable for counters and timestamps which increase steadily.
+		subtract,
+	};
+
+	/**
+	 * Options of delta_encoder.
+	 */
+	struct delta_encoder_options final {
+		delta_method method = delta_method::xor_bytes;
+		// The number of frames from a keyframe to the next keyframe. 0 means that only the first frame is a keyframe.
+		size_t keyframe_interval = 64;
+	};
+
+	/**
+	 * The type of a frame which is the first byte of the frame.
+	 */
+	enum class delta_frame_type : uint8_t {
+		keyframe,
+		xor_delta,
+		subtract_delta,
+	};
+
+	template <typename T, byte_order Order, bool Subtract>
+	void combine_arithmetic_delta_impl(const uint8_t* lhs, const uint8_t* rhs, uint8_t* result);
+
+	template <typename T, byte_order Order, bool Subtract, size_t... Is>
+	void combine_arithmetic_delta_tuple_impl(const uint8_t* lhs, const uint8_t* rhs, uint8_t* result,
+											std::index_sequence<Is...>) {
+		constexpr auto& offsets = serialized_tuple_offsets_v<T>;
+		(combine_arithmetic_delta_impl<remove_cvref_t<std::tuple_element_t<Is, T>>, Order, Subtract>(
+			lhs + offsets[Is], rhs + offsets[Is], result + offsets[Is]), ...);
+	}
+
+	/**
+	 * Calculate lhs - rhs or lhs + rhs for each arithmetic value in serialized data of T. Values are treated as unsigned integers of the same size, so the calculation is reversible.
+	 */
+	template <typename T, byte_order Order, bool Subtract>
+	void combine_arithmetic_delta_impl(const uint8_t* lhs, const uint8_t* rhs, uint8_t* result) {
+		if constexpr (is_serializable_builtin_type_v<T> || is_serializable_enum_v<T>) {
+			constexpr auto size = sizeof(T);
+			using uint_t = std::conditional_t<size == 1, uint8_t, std::conditional_t<
+												size == 2, uint16_t, std::conditional_t<size == 4, uint32_t, uint64_t>>>;
+			uint_t lhs_value;
+			uint_t rhs_value;
+			std::memcpy(&lhs_value, lhs, size);
+			std::memcpy(&rhs_value, rhs, size);
+			convert_endian_to_native_inplace<Order>(lhs_value);
+			convert_endian_to_native_inplace<Order>(rhs_value);
+			auto value = static_cast<uint_t>(Subtract ? lhs_value - rhs_value : lhs_value + rhs_value);
+			convert_endian_native_to_inplace<Order>(value);
+			std::memcpy(result, &value, size);
+		}
+		else if constexpr (is_std_array_v<T>) {
+			using element_type = typename T::value_type;
+			constexpr auto element_size = serialized_size_v<element_type>;
+			for (size_t i = 0; i < std::tuple_size_v<T>; ++i) {
+				combine_arithmetic_delta_impl<element_type, Order, Subtract>(
+					lhs + i * element_size, rhs + i * element_size, result + i * element_size);
+			}
+		}
+		else if constexpr (is_serializable_tuple_v<T>) {
+			combine_arithmetic_delta_tuple_impl<T, Order, Subtract>(lhs, rhs, result,
+																	std::make_index_sequence<std::tuple_size_v<T>>{});
+		}
+		else if constexpr (is_serializable_custom_type_v<T> && !is_bit_packed_v<T>) {
+			using target_types = typename serialize_targets_t<T>::types;
+			combine_arithmetic_delta_tuple_impl<target_types, Order, Subtract>(
+				lhs, rhs, result, std::make_index_sequence<std::tuple_size_v<target_types>>{});
+		}
+		else {
+			// Strings and bit packed types are calculated for each byte.
+			for (size_t i = 0; i < serialized_size_v<T>; ++i) {
+				result[i] = static_cast<uint8_t>(Subtract ? lhs[i] - rhs[i] : lhs[i] + rhs[i]);
+			}
+		}
+	}
+
+	/**
+	 * Count zero bytes from the top of data.
+	 */
+	inline size_t count_leading_zero_bytes(const uint8_t* data, const size_t size) noexcept {
+		size_t count = 0;
+		// Check 8 bytes at once while they are all zero.
+		for (uint64_t word; count + sizeof(word) <= size; count += sizeof(word)) {
+			std::memcpy(&word, data + count, sizeof(word));
+			if (word != 0) {
+				break;
+			}
+		}
+		while (count < size && data[count] == 0) {
+			++count;
+		}
+		return count;
+	}
+
+	/**
+	 * Encode a delta as runs of zero bytes and literal bytes. Each run is a varint of the number of zero bytes, a varint of the number of literal bytes and the literal bytes.
+	 * Zero runs shorter than 3 bytes are included in literals because a new run costs 2 bytes.
+	 * @return The size of encoded data, or 0 if it exceeds the capacity.
+	 */
+	inline size_t encode_zero_runs(const uint8_t* delta, const size_t size, uint8_t* data, const size_t capacity) noexcept {
+		constexpr size_t min_zero_run = 3;
+		size_t position = 0;
+		size_t data_size = 0;
+		while (position < size) {
+			const auto zero_count = count_leading_zero_bytes(delta + position, size - position);
+			position += zero_count;
+			const auto literal_begin = position;
+			while (position < size) {
+				if (delta[position] != 0) {
+					++position;
+					continue;
+				}
+				const auto zero_run = count_leading_zero_bytes(delta + position, size - position);
+				if (zero_run >= min_zero_run || position + zero_run == size) {
+					break;
+				}
+				position += zero_run;
+			}
+
+			const auto literal_count = position - literal_begin;
+			if (data_size + get_varint_size(zero_count) + get_varint_size(literal_count) + literal_count > capacity) {
+				return 0;
+			}
+			auto* out = write_varint(literal_count, write_varint(zero_count, data + data_size));
+			std::memcpy(out, delta + literal_begin, literal_count);
+			data_size = static_cast<size_t>(out - data) + literal_count;
+		}
+		return data_size;
+	}
+
+	/**
+	 * An encoder which encodes each record as a delta against the previous record followed by zero run encoding, with periodic keyframes.
+	 * The delta is calculated on serialized data, so fields in consecutive records line up byte for byte.
+	 * A frame is a frame type byte followed by serialized data for keyframes or zero run encoded delta. A delta frame which is not smaller than serialized data is replaced with a keyframe.
+	 * @tparam T The type of records.
+	 * @tparam Order The byte order of serialized data.
+	 */
+	template <typename T, byte_order Order = byte_order::big>
+	class delta_encoder final {
+	public:
+		/**
+		 * The serialized size of a record.
+		 */
+		static constexpr size_t record_size = serialized_size_v<T, Order>;
+
+		/**
+		 * The maximum size of a frame.
+		 */
+		static constexpr size_t max_frame_size = 1 + record_size;
+
+		/**
+		 * @brief Create an encoder.
+		 * @param options Options of the encoder.
+		 */
+		explicit delta_encoder(const delta_encoder_options& options = {}) : options_(options) {}
+
+		/**
+		 * @brief Encode a record as a frame to buffer.
+		 * @param obj A record to encode.
+		 * @param buffer A destination buffer which has data() and size() member function.
+		 * @param offset A start position of the buffer.
+		 * @return The size of the frame.
+		 * @throw serialization_error Serialization is failed.
+		 */
+		template <typename Buffer>
+		auto encode(const T& obj, Buffer& buffer, const size_t offset = 0) -> decltype(
+			std::declval<Buffer>().data(), std::declval<Buffer>().size(), size_t()) {
+			if (offset > buffer.size() || buffer.size() - offset < max_frame_size) {
+				throw serialization_error("Serialization source is out of range.");
+			}
+			return encode_impl(obj, buffer.data() + offset);
+		}
+
+		/**
+		 * @brief Encode a record as a frame to sink. max_frame_size bytes are reserved and only the size of the frame is committed.
+		 * @param obj A record to encode.
+		 * @param sink A destination sink which satisfies is_serialization_sink_v.
+		 * @return The size of the frame.
+		 * @throw serialization_error Serialization is failed.
+		 */
+		template <typename Sink>
+		auto encode(const T& obj, Sink& sink) -> std::enable_if_t<is_serialization_sink_v<Sink>, size_t> {
+			const auto data = sink.reserve(max_frame_size);
+			if (data == nullptr) {
+				throw serialization_error("Serialization source is out of range.");
+			}
+			const auto size = encode_impl(obj, data);
+			sink.commit(size);
+			return size;
+		}
+
+		/**
+		 * @brief Make the next frame a keyframe, for example when a new file is started.
+		 */
+		void reset() noexcept {
+			has_previous_ = false;
+		}
+
+	private:
+		delta_encoder_options options_;
+		serialized_data<T, Order> previous_;
+		serialized_data<T, Order> delta_;
+		bool has_previous_ = false;
+		size_t frames_since_keyframe_ = 0;
+
+		size_t encode_impl(const T& obj, uint8_t* data) {
+			serialized_data<T, Order> current;
+			serialize_impl<T, Order>(obj, current.data());
+
+			size_t size = 0;
+			if (has_previous_ && (options_.keyframe_interval == 0 || frames_since_keyframe_ < options_.keyframe_interval)) {
+				size = encode_delta(current, data);
+			}
+			if (size == 0) {
+				data[0] = static_cast<uint8_t>(delta_frame_type::keyframe);
+				std::memcpy(data + 1, current.data(), record_size);
+				size = max_frame_size;
+				frames_since_keyframe_ = 0;
+			}
+			++frames_since_keyframe_;
+			previous_ = current;
+			has_previous_ = true;
+			return size;
+		}
+
+		// Return 0 if the delta frame is not smaller than a keyframe.
+		size_t encode_delta(const serialized_data<T, Order>& current, uint8_t* data) {
+			if (options_.method == delta_method::xor_bytes) {
+				data[0] = static_cast<uint8_t>(delta_frame_type::xor_delta);
+				for (size_t i = 0; i < record_size; ++i) {
+					delta_[i] = current[i] ^ previous_[i];
+				}
+			}
+			else {
+				data[0] = static_cast<uint8_t>(delta_frame_type::subtract_delta);
+				combine_arithmetic_delta_impl<T, Order, true>(current.data(), previous_.data(), delta_.data());
+			}
+			const auto size = encode_zero_runs(delta_.data(), record_size, data + 1, record_size - 1);
+			// A delta which is all zero is encoded as zero runs whose size is not zero.
+			return size == 0 ? 0 : 1 + size;
+		}
+	};
+
+	/**
+	 * A decoder of frames encoded by delta_encoder.
+	 * @tparam T The type of records.
+	 * @tparam Order The byte order of serialized data.
+	 */
+	template <typename T, byte_order Order = byte_order::big>
+	class delta_decoder final {
+	public:
+		/**
+		 * The serialized size of a record.
+		 */
+		static constexpr size_t record_size = serialized_size_v<T, Order>;
+
+		/**
+		 * @brief Decode a frame in buffer.
+		 * @param obj A record to decode.
+		 * @param buffer A source buffer which has data() and size() member function.
+		 * @param offset A start position of the buffer.
+		 * @return The size of the frame.
+		 * @throw serialization_error Deserialization is failed, the frame is malformed or a delta frame precedes any keyframe.
+		 */
+		template <typename Buffer>
+		auto decode(T& obj, const Buffer& buffer, const size_t offset = 0) -> decltype(
+			std::declval<Buffer>().data(), std::declval<Buffer>().size(), size_t()) {
+			if (offset >= buffer.size()) {
+				throw serialization_error("Deserialization destination is out of range.");
+			}
+
+			const auto begin = buffer.data() + offset;
+			const auto end = buffer.data() + buffer.size();
+			const auto type = static_cast<delta_frame_type>(begin[0]);
+			const uint8_t* data = begin + 1;
+			if (type == delta_frame_type::keyframe) {
+				if (static_cast<size_t>(end - data) < record_size) {
+					throw serialization_error("Deserialization destination is out of range.");
+				}
+				std::memcpy(current_.data(), data, record_size);
+				data += record_size;
+			}
+			else if (type == delta_frame_type::xor_delta || type == delta_frame_type::subtract_delta) {
+				if (!has_current_) {
+					throw serialization_error("A delta frame must follow a keyframe.");
+				}
+				data = type == delta_frame_type::xor_delta ? decode_xor_delta(data, end) : decode_subtract_delta(data, end);
+			}
+			else {
+				throw serialization_error("Unknown delta frame type.");
+			}
+
+			has_current_ = true;
+			deserialize_impl<T, Order>(obj, current_.data());
+			return static_cast<size_t>(data - begin);
+		}
+
+		/**
+		 * @brief Require a keyframe for the next frame.
+		 */
+		void reset() noexcept {
+			has_current_ = false;
+		}
+
+	private:
+		serialized_data<T, Order> current_;
+		serialized_data<T, Order> delta_;
+		bool has_current_ = false;
+
+		// Call func(position, literals, count) for each literal run and return the end of encoded data.
+		template <typename Func>
+		static const uint8_t* decode_zero_runs(const uint8_t* data, const uint8_t* end, Func&& func) {
+			size_t position = 0;
+			while (position < record_size) {
+				size_t zero_count;
+				size_t literal_count;
+				data = read_varint(zero_count, data, end);
+				data = read_varint(literal_count, data, end);
+				if (zero_count > record_size - position || literal_count > record_size - position - zero_count ||
+					zero_count + literal_count == 0) {
+					throw serialization_error("Delta frame is malformed.");
+				}
+				if (static_cast<size_t>(end - data) < literal_count) {
+					throw serialization_error("Deserialization destination is out of range.");
+				}
+				position += zero_count;
+				func(position, data, literal_count);
+				position += literal_count;
+				data += literal_count;
+			}
+			return data;
+		}
+
+		const uint8_t* decode_xor_delta(const uint8_t* data, const uint8_t* end) {
+			// Validate the whole frame first so that a malformed frame does not corrupt the previous record.
+			const auto frame_end = decode_zero_runs(data, end, [](size_t, const uint8_t*, size_t) {});
+			// Zero runs do not change bytes, so only literals are applied to the previous record in place.
+			decode_zero_runs(data, end, [this](const size_t position, const uint8_t* literals, const size_t count) {
+				for (size_t i = 0; i < count; ++i) {
+					current_[position + i] ^= literals[i];
+				}
+			});
+			return frame_end;
+		}
+
+		const uint8_t* decode_subtract_delta(const uint8_t* data, const uint8_t* end) {
+			delta_.fill(0);
+			data = decode_zero_runs(data, end, [this](const size_t position, const uint8_t* literals, const size_t count) {
+				std::memcpy(delta_.data() + position, literals, count);
+			});
+			combine_arithmetic_delta_impl<T, Order, false>(current_.data(), delta_.data(), current_.data());
+			return data;
+		}
+	};
+}
@@ -0,0 +1,213 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "serializer.hpp"
+
+namespace minimal_serializer {
+	template <typename Message, typename Tuple, size_t... Is>
+	constexpr size_t get_framed_message_id_impl(std::index_sequence<Is...>) {
+		constexpr size_t count = (static_cast<size_t>(std::is_same_v<Message, std::tuple_element_t<Is, Tuple>>) + ...);
+		static_assert(count == 1, "A message type must appear exactly once in a message list.");
+		size_t id = 0;
+		// Only one term is nonzero.
+		((id += std::is_same_v<Message, std::tuple_element_t<Is, Tuple>> ? Is : 0), ...);
+		return id;
+	}
+
+	/**
+	 * @brief The dense ID of a message type in a message list, which is the index of the type in the std::tuple.
+	 * @tparam MessageList A std::tuple of serializable message types.
+	 * @tparam Message A message type in the list.
+	 */
+	template <typename MessageList, typename Message>
+	constexpr size_t framed_message_id_v = get_framed_message_id_impl<remove_cvref_t<Message>, MessageList>(
+		std::make_index_sequence<std::tuple_size_v<MessageList>>{});
+
+	/**
+	 * @brief The type of IDs in frame headers. One byte is used for up to 256 message types.
+	 * @tparam MessageList A std::tuple of serializable message types.
+	 */
+	template <typename MessageList>
+	using frame_header_t = std::conditional_t<std::tuple_size_v<MessageList> <= 0x100, uint8_t, uint16_t>;
+
+	/**
+	 * @brief The size of frame headers.
+	 * @tparam MessageList A std::tuple of serializable message types.
+	 */
+	template <typename MessageList>
+	constexpr size_t frame_header_size_v = sizeof(frame_header_t<MessageList>);
+
+	/**
+	 * @brief The size of a framed message which is a frame header followed by serialized data of the message.
+	 * @tparam MessageList A std::tuple of serializable message types.
+	 * @tparam Message A message type in the list.
+	 * @tparam Order The byte order of serialized data.
+	 */
+	template <typename MessageList, typename Message, byte_order Order = byte_order::big>
+	constexpr size_t framed_size_v = frame_header_size_v<MessageList> + serialized_size_v<Message, Order>;
+
+	template <typename MessageList, byte_order Order, typename Message>
+	void encode_framed_impl(const Message& message, uint8_t* data) {
+		static_assert(std::tuple_size_v<MessageList> <= 0x10000, "The number of message types must be 65536 or less.");
+		using header_type = frame_header_t<MessageList>;
+		constexpr auto id = static_cast<header_type>(framed_message_id_v<MessageList, Message>);
+		serialize_impl<header_type, Order>(id, data);
+		serialize_impl<Message, Order>(message, data + frame_header_size_v<MessageList>);
+	}
+
+	/**
+	 * Serialize a message with a frame header which identifies the type of the message.
+	 *
+	 * @param message A message to serialize.
+	 * @tparam MessageList A std::tuple of serializable message types. The ID of a message type is its index in the tuple.
+	 * @tparam Order The byte order of serialized data.
+	 * @tparam Message The type of the message which is in the message list.
+	 * @return A framed byte array.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <typename MessageList, byte_order Order, typename Message>
+	std::array<uint8_t, framed_size_v<MessageList, Message, Order>> encode_framed(const Message& message) {
+		std::array<uint8_t, framed_size_v<MessageList, Message, Order>> data;
+		encode_framed_impl<MessageList, Order>(message, data.data());
+		return data;
+	}
+
+	/**
+	 * Serialize a message with a frame header which identifies the type of the message in big endian.
+	 *
+	 * @param message A message to serialize.
+	 * @tparam MessageList A std::tuple of serializable message types. The ID of a message type is its index in the tuple.
+	 * @tparam Message The type of the message which is in the message list.
+	 * @return A framed byte array.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <typename MessageList, typename Message>
+	std::array<uint8_t, framed_size_v<MessageList, Message>> encode_framed(const Message& message) {
+		return encode_framed<MessageList, byte_order::big>(message);
+	}
+
+	/**
+	 * Serialize a message with a frame header which identifies the type of the message to buffer.
+	 *
+	 * @param message A message to serialize.
+	 * @param buffer A destination buffer which has data() and size() member function.
+	 * @param offset A start position of the buffer.
+	 * @tparam MessageList A std::tuple of serializable message types. The ID of a message type is its index in the tuple.
+	 * @tparam Order The byte order of serialized data.
+	 * @tparam Message The type of the message which is in the message list.
+	 * @return The number of written bytes.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <typename MessageList, byte_order Order, typename Message, typename Buffer>
+	auto encode_framed(const Message& message, Buffer& buffer, const size_t offset = 0) -> decltype(
+		std::declval<Buffer>().data(), std::declval<Buffer>().size(), size_t()) {
+		constexpr auto size = framed_size_v<MessageList, Message, Order>;
+		if (offset > buffer.size() || buffer.size() - offset < size) {
+			throw serialization_error("Serialization source is out of range.");
+		}
+
+		encode_framed_impl<MessageList, Order>(message, buffer.data() + offset);
+		return size;
+	}
+
+	/**
+	 * Serialize a message with a frame header which identifies the type of the message to buffer in big endian.
+	 *
+	 * @param message A message to serialize.
+	 * @param buffer A destination buffer which has data() and size() member function.
+	 * @param offset A start position of the buffer.
+	 * @tparam MessageList A std::tuple of serializable message types. The ID of a message type is its index in the tuple.
+	 * @tparam Message The type of the message which is in the message list.
+	 * @return The number of written bytes.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <typename MessageList, typename Message, typename Buffer>
+	auto encode_framed(const Message& message, Buffer& buffer, const size_t offset = 0) -> decltype(
+		std::declval<Buffer>().data(), std::declval<Buffer>().size(), size_t()) {
+		return encode_framed<MessageList, byte_order::big>(message, buffer, offset);
+	}
+
+	template <typename MessageList, byte_order Order, size_t I, typename Visitor>
+	size_t dispatch_framed_message(const uint8_t* data, const size_t size, Visitor& visitor) {
+		using message_type = std::tuple_element_t<I, MessageList>;
+		constexpr auto message_size = serialized_size_v<message_type, Order>;
+		if (size < message_size) {
+			throw serialization_error("Deserialization destination is out of range.");
+		}
+
+		message_type message{};
+		deserialize_impl<message_type, Order>(message, data);
+		visitor(message);
+		return message_size;
+	}
+
+	template <typename MessageList, byte_order Order, typename Visitor, size_t... Is>
+	constexpr auto make_dispatch_table(std::index_sequence<Is...>) {
+		using handler_type = size_t (*)(const uint8_t*, size_t, Visitor&);
+		return std::array<handler_type, sizeof...(Is)>{&dispatch_framed_message<MessageList, Order, Is, Visitor>...};
+	}
+
+	/**
+	 * Deserialize a framed message and call a visitor with it. The type of the message is selected by the ID in the frame header through a table generated in compile time.
+	 *
+	 * @param buffer A source buffer which has data() and size() member function.
+	 * @param visitor A function object which can be called with a reference to each message type in the message list.
+	 * @param offset A start position of the buffer.
+	 * @tparam MessageList A std::tuple of serializable message types. The ID of a message type is its index in the tuple.
+	 * @tparam Order The byte order of serialized data.
+	 * @return The number of read bytes including the frame header.
+	 * @throw serialization_error Deserialization is failed or the ID is unknown.
+	 */
+	template <typename MessageList, byte_order Order, typename Buffer, typename Visitor>
+	auto dispatch(const Buffer& buffer, Visitor&& visitor, const size_t offset = 0) -> decltype(
+		std::declval<Buffer>().data(), std::declval<Buffer>().size(), size_t()) {
+		using header_type = frame_header_t<MessageList>;
+		using visitor_type = std::remove_reference_t<Visitor>;
+		constexpr auto header_size = frame_header_size_v<MessageList>;
+		static constexpr auto table = make_dispatch_table<MessageList, Order, visitor_type>(
+			std::make_index_sequence<std::tuple_size_v<MessageList>>{});
+
+		if (offset > buffer.size() || buffer.size() - offset < header_size) {
+			throw serialization_error("Deserialization destination is out of range.");
+		}
+		const auto data = buffer.data() + offset;
+		header_type id;
+		deserialize_impl<header_type, Order>(id, data);
+		if (id >= table.size()) {
+			throw serialization_error("Unknown message type ID.");
+		}
+
+		return header_size + table[id](data + header_size, buffer.size() - offset - header_size, visitor);
+	}
+
+	/**
+	 * Deserialize a framed message in big endian and call a visitor with it. The type of the message is selected by the ID in the frame header through a table generated in compile time.
+	 *
+	 * @param buffer A source buffer which has data() and size() member function.
+	 * @param visitor A function object which can be called with a reference to each message type in the message list.
+	 * @param offset A start position of the buffer.
+	 * @tparam MessageList A std::tuple of serializable message types. The ID of a message type is its index in the tuple.
+	 * @return The number of read bytes including the frame header.
+	 * @throw serialization_error Deserialization is failed or the ID is unknown.
+	 */
+	template <typename MessageList, typename Buffer, typename Visitor>
+	auto dispatch(const Buffer& buffer, Visitor&& visitor, const size_t offset = 0) -> decltype(
+		std::declval<Buffer>().data(), std::declval<Buffer>().size(), size_t()) {
+		return dispatch<MessageList, byte_order::big>(buffer, std::forward<Visitor>(visitor), offset);
+	}
+}
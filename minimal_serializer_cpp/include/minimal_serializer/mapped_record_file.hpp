@@ -0,0 +1,487 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "posix_io.hpp"
+
+#ifdef MINIMAL_SERIALIZER_POSIX_IO
+#include <iterator>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "serialized_view.hpp"
+
+namespace minimal_serializer {
+	/**
+	 * How a mapped_record_file opens a file.
+	 */
+	enum class mapped_file_mode {
+		// Open an existing file only for reading.
+		read_only,
+		// Open a file for reading and writing. The file is created if it does not exist.
+		read_write,
+	};
+
+	/**
+	 * Access patterns passed to madvise as hints.
+	 */
+	enum class access_pattern {
+		normal,
+		sequential,
+		random,
+		will_need,
+	};
+
+	/**
+	 * @brief A file of fixed size records mapped to memory. The i-th record is at header_size + i * serialized_size_v<T> in the file, so any record is accessed in constant time.
+	 * Records are deserialized on access. A trailing incomplete record in the file is ignored.
+	 * @tparam T The type of records.
+	 * @tparam Order The byte order of serialized data.
+	 */
+	template <typename T, byte_order Order = byte_order::big>
+	class mapped_record_file final {
+	public:
+		/**
+		 * The serialized size of a record.
+		 */
+		static constexpr size_t record_size = serialized_size_v<T, Order>;
+
+		/**
+		 * @brief A random access iterator which deserializes a record on dereference.
+		 */
+		class const_iterator final {
+		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			// Records are returned by value because they are deserialized on access.
+			using reference = T;
+
+			const_iterator() noexcept = default;
+
+			const_iterator(const mapped_record_file* file, const size_t index) noexcept : file_(file), index_(index) {}
+
+			T operator*() const {
+				return (*file_)[index_];
+			}
+
+			T operator[](const difference_type n) const {
+				return (*file_)[index_ + n];
+			}
+
+			const_iterator& operator++() noexcept {
+				++index_;
+				return *this;
+			}
+
+			const_iterator operator++(int) noexcept {
+				auto it = *this;
+				++index_;
+				return it;
+			}
+
+			const_iterator& operator--() noexcept {
+				--index_;
+				return *this;
+			}
+
+			const_iterator operator--(int) noexcept {
+				auto it = *this;
+				--index_;
+				return it;
+			}
+
+			const_iterator& operator+=(const difference_type n) noexcept {
+				index_ += n;
+				return *this;
+			}
+
+			const_iterator& operator-=(const difference_type n) noexcept {
+				index_ -= n;
+				return *this;
+			}
+
+			friend const_iterator operator+(const_iterator it, const difference_type n) noexcept {
+				return it += n;
+			}
+
+			friend const_iterator operator+(const difference_type n, const_iterator it) noexcept {
+				return it += n;
+			}
+
+			friend const_iterator operator-(const_iterator it, const difference_type n) noexcept {
+				return it -= n;
+			}
+
+			friend difference_type operator-(const const_iterator& lhs, const const_iterator& rhs) noexcept {
+				return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+			}
+
+			friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) noexcept {
+				return lhs.index_ == rhs.index_;
+			}
+
+			friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs) noexcept {
+				return lhs.index_ != rhs.index_;
+			}
+
+			friend bool operator<(const const_iterator& lhs, const const_iterator& rhs) noexcept {
+				return lhs.index_ < rhs.index_;
+			}
+
+			friend bool operator>(const const_iterator& lhs, const const_iterator& rhs) noexcept {
+				return lhs.index_ > rhs.index_;
+			}
+
+			friend bool operator<=(const const_iterator& lhs, const const_iterator& rhs) noexcept {
+				return lhs.index_ <= rhs.index_;
+			}
+
+			friend bool operator>=(const const_iterator& lhs, const const_iterator& rhs) noexcept {
+				return lhs.index_ >= rhs.index_;
+			}
+
+		private:
+			const mapped_record_file* file_ = nullptr;
+			size_t index_ = 0;
+		};
+
+		/**
+		 * @brief Open and map a file.
+		 * @param path The path of the file.
+		 * @param mode The mode to open the file.
+		 * @param header_size The size of a header before records. A new file is extended to have the header filled with zero.
+		 * @throw std::system_error Opening or mapping the file is failed.
+		 * @throw serialization_error The file opened as read only is smaller than the header.
+		 */
+		explicit mapped_record_file(const char* path, const mapped_file_mode mode = mapped_file_mode::read_only,
+									const size_t header_size = 0) : mode_(mode), header_size_(header_size) {
+			fd_ = ::open(path, mode == mapped_file_mode::read_only ? O_RDONLY : O_RDWR | O_CREAT, 0644);
+			if (fd_ < 0) {
+				throw_last_system_error("Failed to open the file.");
+			}
+
+			try {
+				struct stat st{};
+				if (::fstat(fd_, &st) != 0) {
+					throw_last_system_error("Failed to get the size of the file.");
+				}
+				auto file_size = static_cast<size_t>(st.st_size);
+				if (file_size < header_size_) {
+					if (mode_ == mapped_file_mode::read_only) {
+						throw serialization_error("The file is smaller than the header.");
+					}
+					resize_file(header_size_);
+					file_size = header_size_;
+				}
+				size_ = (file_size - header_size_) / record_size;
+				capacity_ = size_;
+				map(header_size_ + capacity_ * record_size);
+			}
+			catch (...) {
+				::close(fd_);
+				throw;
+			}
+		}
+
+		mapped_record_file(const mapped_record_file&) = delete;
+		mapped_record_file(mapped_record_file&&) = delete;
+
+		/**
+		 * @brief Unmap and close the file. Extra space allocated by appending is truncated.
+		 */
+		~mapped_record_file() {
+			unmap();
+			if (mode_ == mapped_file_mode::read_write && capacity_ != size_) {
+				// The destructor must not throw, and records are already in the file even if truncation is failed.
+				(void)::ftruncate(fd_, static_cast<off_t>(header_size_ + size_ * record_size));
+			}
+			::close(fd_);
+		}
+
+		mapped_record_file& operator=(const mapped_record_file&) = delete;
+		mapped_record_file& operator=(mapped_record_file&&) = delete;
+
+		/**
+		 * @brief Get the number of records.
+		 * @return The number of records.
+		 */
+		[[nodiscard]] size_t size() const noexcept {
+			return size_;
+		}
+
+		/**
+		 * @brief Check whether there are no records.
+		 * @return Whether there are no records.
+		 */
+		[[nodiscard]] bool empty() const noexcept {
+			return size_ == 0;
+		}
+
+		/**
+		 * @brief Get the pointer to the header.
+		 * @return The pointer to the header, or nullptr if the file is empty.
+		 */
+		[[nodiscard]] const uint8_t* header_data() const noexcept {
+			return mapping_;
+		}
+
+		/**
+		 * @brief Get the pointer to the header. The file must be opened as read_write to modify the header.
+		 * @return The pointer to the header, or nullptr if the file is empty.
+		 */
+		[[nodiscard]] uint8_t* header_data() noexcept {
+			return mapping_;
+		}
+
+		/**
+		 * @brief Get the pointer to serialized data of a record. The index is not checked.
+		 * @param index The index of the record.
+		 * @return The pointer to serialized data of the record.
+		 */
+		[[nodiscard]] const uint8_t* record_data(const size_t index) const noexcept {
+			return mapping_ + header_size_ + index * record_size;
+		}
+
+		/**
+		 * @brief Deserialize a record. The index is not checked.
+		 * @param index The index of the record.
+		 * @return The deserialized record.
+		 */
+		T operator[](const size_t index) const {
+			T obj{};
+			deserialize_impl<T, Order>(obj, record_data(index));
+			return obj;
+		}
+
+		/**
+		 * @brief Deserialize a record.
+		 * @param index The index of the record.
+		 * @return The deserialized record.
+		 * @throw std::out_of_range The index is out of range.
+		 */
+		[[nodiscard]] T at(const size_t index) const {
+			check_index(index);
+			return (*this)[index];
+		}
+
+		/**
+		 * @brief Get a view of a record which reads only accessed members. The index is not checked.
+		 * @param index The index of the record.
+		 * @return A view of the record.
+		 */
+		template <typename U = T>
+		[[nodiscard]] serialized_view<U, Order> view(const size_t index) const noexcept {
+			return serialized_view<U, Order>(record_data(index));
+		}
+
+		/**
+		 * @brief Overwrite a record. The file must be opened as read_write.
+		 * @param index The index of the record.
+		 * @param obj A new record.
+		 * @throw std::out_of_range The index is out of range.
+		 */
+		void set(const size_t index, const T& obj) {
+			check_writable();
+			check_index(index);
+			serialize_impl<T, Order>(obj, mapping_ + header_size_ + index * record_size);
+		}
+
+		/**
+		 * @brief Append a record at the end of the file. The file is extended geometrically and remapped if there is no space. The file must be opened as read_write.
+		 * @param obj A record to append.
+		 * @throw std::system_error Extending or remapping the file is failed.
+		 */
+		void push_back(const T& obj) {
+			check_writable();
+			if (size_ == capacity_) {
+				reserve(std::max<size_t>(capacity_ * 2, 16));
+			}
+			serialize_impl<T, Order>(obj, mapping_ + header_size_ + size_ * record_size);
+			++size_;
+		}
+
+		/**
+		 * @brief Append contiguous records at the end of the file. The file must be opened as read_write.
+		 * @param objects A source range which has data() and size() member function such as std::vector<T> and std::span<const T>.
+		 * @throw std::system_error Extending or remapping the file is failed.
+		 */
+		template <typename Range>
+		auto append_range(Range&& objects) -> decltype(objects.data(), objects.size(), void()) {
+			static_assert(std::is_same_v<remove_cvref_t<decltype(*objects.data())>, T>, "Elements of the range must be T.");
+			check_writable();
+			const auto count = static_cast<size_t>(objects.size());
+			if (capacity_ - size_ < count) {
+				reserve(std::max(size_ + count, capacity_ * 2));
+			}
+			if (count > 0) {
+				serialize_array_impl<T, Order>(objects.data(), count, mapping_ + header_size_ + size_ * record_size);
+			}
+			size_ += count;
+		}
+
+		/**
+		 * @brief Extend the file to have space for records and remap it. The file must be opened as read_write.
+		 * @param capacity The number of records.
+		 * @throw std::system_error Extending or remapping the file is failed.
+		 */
+		void reserve(const size_t capacity) {
+			check_writable();
+			if (capacity <= capacity_) {
+				return;
+			}
+			const auto mapping_size = header_size_ + capacity * record_size;
+			resize_file(mapping_size);
+			try {
+				remap(mapping_size);
+			}
+			catch (...) {
+				// Keep the file consistent with the current mapping. Records are not lost because they are within the old size.
+				(void)::ftruncate(fd_, static_cast<off_t>(header_size_ + capacity_ * record_size));
+				throw;
+			}
+			capacity_ = capacity;
+			apply_advice();
+		}
+
+		/**
+		 * @brief Give a hint of the access pattern to the kernel by madvise. The hint is applied again after remapping.
+		 * @param pattern The access pattern.
+		 * @throw std::system_error madvise is failed.
+		 */
+		void advise(const access_pattern pattern) {
+			pattern_ = pattern;
+			apply_advice();
+		}
+
+		/**
+		 * @brief Write modified records back to the file by msync and wait for it to finish.
+		 * @throw std::system_error msync is failed.
+		 */
+		void sync() {
+			if (mapping_ != nullptr && ::msync(mapping_, mapping_size_, MS_SYNC) != 0) {
+				throw_last_system_error("Failed to synchronize the mapped file.");
+			}
+		}
+
+		[[nodiscard]] const_iterator begin() const noexcept {
+			return const_iterator(this, 0);
+		}
+
+		[[nodiscard]] const_iterator end() const noexcept {
+			return const_iterator(this, size_);
+		}
+
+	private:
+		int fd_ = -1;
+		mapped_file_mode mode_;
+		size_t header_size_;
+		size_t size_ = 0;
+		size_t capacity_ = 0;
+		uint8_t* mapping_ = nullptr;
+		size_t mapping_size_ = 0;
+		access_pattern pattern_ = access_pattern::normal;
+
+		void check_index(const size_t index) const {
+			if (index >= size_) {
+				throw std::out_of_range("The index of the record is out of range.");
+			}
+		}
+
+		void check_writable() const {
+			if (mode_ != mapped_file_mode::read_write) {
+				throw serialization_error("The file is not opened as read_write.");
+			}
+		}
+
+		void resize_file(const size_t size) {
+			if (::ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+				throw_last_system_error("Failed to resize the file.");
+			}
+		}
+
+		void map(const size_t size) {
+			auto* mapping = create_mapping(size);
+			mapping_ = mapping;
+			mapping_size_ = mapping == nullptr ? 0 : size;
+		}
+
+		[[nodiscard]] uint8_t* create_mapping(const size_t size) const {
+			// mmap does not accept zero length.
+			if (size == 0) {
+				return nullptr;
+			}
+			const auto protection = mode_ == mapped_file_mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+			auto* mapping = ::mmap(nullptr, size, protection, MAP_SHARED, fd_, 0);
+			if (mapping == MAP_FAILED) {
+				throw_last_system_error("Failed to map the file.");
+			}
+			return static_cast<uint8_t*>(mapping);
+		}
+
+		void unmap() noexcept {
+			if (mapping_ != nullptr) {
+				::munmap(mapping_, mapping_size_);
+				mapping_ = nullptr;
+				mapping_size_ = 0;
+			}
+		}
+
+		// The current mapping is kept if remapping is failed.
+		void remap(const size_t size) {
+#ifdef __linux__
+			if (mapping_ != nullptr) {
+				// Extend the mapping without unmapping on Linux. The address may be moved.
+				auto* mapping = ::mremap(mapping_, mapping_size_, size, MREMAP_MAYMOVE);
+				if (mapping == MAP_FAILED) {
+					throw_last_system_error("Failed to remap the file.");
+				}
+				mapping_ = static_cast<uint8_t*>(mapping);
+				mapping_size_ = size;
+				return;
+			}
+#endif
+			auto* mapping = create_mapping(size);
+			unmap();
+			mapping_ = mapping;
+			mapping_size_ = size;
+		}
+
+		void apply_advice() {
+			if (mapping_ == nullptr) {
+				return;
+			}
+			int advice;
+			switch (pattern_) {
+			case access_pattern::sequential:
+				advice = MADV_SEQUENTIAL;
+				break;
+			case access_pattern::random:
+				advice = MADV_RANDOM;
+				break;
+			case access_pattern::will_need:
+				advice = MADV_WILLNEED;
+				break;
+			default:
+				advice = MADV_NORMAL;
+				break;
+			}
+			if (::madvise(mapping_, mapping_size_, advice) != 0) {
+				throw_last_system_error("Failed to advise the access pattern.");
+			}
+		}
+	};
+}
+#endif
@@ -0,0 +1,70 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace minimal_serializer {
+	/**
+	 * The size of cache line which is assumed to avoid false sharing.
+	 */
+	constexpr size_t cache_line_size = 64;
+
+	/**
+	 * Round up a value to the smallest power of two which is not less than it.
+	 * @param value A value to round up. 0 is rounded up to 1.
+	 * @return The power of two.
+	 */
+	constexpr size_t round_up_to_power_of_two(const size_t value) noexcept {
+		size_t result = 1;
+		while (result < value) {
+			result <<= 1;
+		}
+		return result;
+	}
+
+	/**
+	 * An allocator adaptor which default-initializes elements instead of value-initializing them when no arguments are passed to construct().
+	 * resize() of containers with this allocator does not fill new elements of trivial types such as uint8_t with zero.
+	 * @tparam T The type of elements.
+	 * @tparam Allocator The underlying allocator such as std::allocator<T> and std::pmr::polymorphic_allocator<T>.
+	 */
+	template <typename T, typename Allocator = std::allocator<T>>
+	class default_init_allocator : public Allocator {
+		using traits = std::allocator_traits<Allocator>;
+
+	public:
+		template <typename U>
+		struct rebind {
+			using other = default_init_allocator<U, typename traits::template rebind_alloc<U>>;
+		};
+
+		using Allocator::Allocator;
+
+		default_init_allocator() = default;
+
+		default_init_allocator(const Allocator& allocator) noexcept : Allocator(allocator) {}
+
+		template <typename U>
+		void construct(U* ptr) noexcept(std::is_nothrow_default_constructible_v<U>) {
+			::new(static_cast<void*>(ptr)) U;
+		}
+
+		template <typename U, typename... Args>
+		void construct(U* ptr, Args&&... args) {
+			traits::construct(static_cast<Allocator&>(*this), ptr, std::forward<Args>(args)...);
+		}
+	};
+}
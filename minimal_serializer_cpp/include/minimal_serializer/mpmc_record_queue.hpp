@@ -0,0 +1,191 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "memory_utility.hpp"
+#include "serializer.hpp"
+
+namespace minimal_serializer {
+	/**
+	 * @brief A bounded lock free queue of slots for serialized records between multiple producer threads and multiple consumer threads.
+	 * Each slot is exactly serialized_size_v<T> bytes and has a sequence number which tells whether the slot is ready to write or read in the current lap.
+	 * Batch operations claim multiple contiguous slots with one compare and exchange and serialize or deserialize records directly in the slots.
+	 * @tparam T The type of records.
+	 * @tparam Order The byte order of serialized data.
+	 */
+	template <typename T, byte_order Order = byte_order::big>
+	class mpmc_record_queue final {
+	public:
+		/**
+		 * The serialized size of a record, which is the size of a slot.
+		 */
+		static constexpr size_t record_size = serialized_size_v<T, Order>;
+
+		/**
+		 * @brief Create a queue.
+		 * @param capacity The number of slots. This is rounded up to a power of two.
+		 */
+		explicit mpmc_record_queue(const size_t capacity) : capacity_(round_up_to_power_of_two(capacity)),
+															mask_(capacity_ - 1),
+															sequences_(std::make_unique<std::atomic<uint64_t>[]>(capacity_)),
+															slots_(std::make_unique<uint8_t[]>(capacity_ * record_size)) {
+			// A slot is writable at position p when its sequence number is p, and readable when it is p + 1.
+			for (size_t i = 0; i < capacity_; ++i) {
+				sequences_[i].store(i, std::memory_order_relaxed);
+			}
+		}
+
+		mpmc_record_queue(const mpmc_record_queue&) = delete;
+		mpmc_record_queue(mpmc_record_queue&&) = delete;
+		~mpmc_record_queue() = default;
+		mpmc_record_queue& operator=(const mpmc_record_queue&) = delete;
+		mpmc_record_queue& operator=(mpmc_record_queue&&) = delete;
+
+		/**
+		 * @brief Get the number of slots.
+		 * @return The number of slots.
+		 */
+		[[nodiscard]] size_t capacity() const noexcept {
+			return capacity_;
+		}
+
+		/**
+		 * @brief Serialize a record into a free slot.
+		 * @param obj A record to push.
+		 * @return Whether the record is pushed. This is false if the queue is full.
+		 */
+		bool try_push(const T& obj) {
+			return try_push_batch_impl(&obj, 1) == 1;
+		}
+
+		/**
+		 * @brief Deserialize the oldest record and remove it.
+		 * @param obj A destination object.
+		 * @return Whether a record is popped. This is false if the queue is empty.
+		 */
+		bool try_pop(T& obj) {
+			return try_pop_batch_impl(&obj, 1) == 1;
+		}
+
+		/**
+		 * @brief Serialize records into free slots claimed at once. Records may be pushed partially if there are not enough free slots.
+		 * @param objects A source range which has data() and size() member function such as std::vector<T> and std::span<const T>.
+		 * @return The number of pushed records from the front of the range.
+		 */
+		template <typename Range>
+		auto try_push_batch(Range&& objects) -> decltype(objects.data(), objects.size(), size_t()) {
+			static_assert(std::is_same_v<remove_cvref_t<decltype(*objects.data())>, T>, "Elements of the range must be T.");
+			return try_push_batch_impl(objects.data(), static_cast<size_t>(objects.size()));
+		}
+
+		/**
+		 * @brief Deserialize the oldest records claimed at once and remove them. Records may be popped partially if there are not enough records.
+		 * @param objects A destination range which has data() and size() member function such as std::vector<T> and std::span<T>.
+		 * @return The number of popped records stored from the front of the range.
+		 */
+		template <typename Range>
+		auto try_pop_batch(Range&& objects) -> decltype(objects.data(), objects.size(),
+														std::enable_if_t<!std::is_const_v<std::remove_reference_t<
+															decltype(*objects.data())>>, size_t>()) {
+			static_assert(std::is_same_v<remove_cvref_t<decltype(*objects.data())>, T>, "Elements of the range must be T.");
+			return try_pop_batch_impl(objects.data(), static_cast<size_t>(objects.size()));
+		}
+
+	private:
+		// Positions are placed on different cache lines because producers and consumers update them concurrently.
+		struct alignas(cache_line_size) position final {
+			std::atomic<uint64_t> value{0};
+		};
+
+		position enqueue_position_;
+		position dequeue_position_;
+		size_t capacity_;
+		size_t mask_;
+		std::unique_ptr<std::atomic<uint64_t>[]> sequences_;
+		std::unique_ptr<uint8_t[]> slots_;
+
+		// Count slots from the position whose sequence numbers are position + offset + i up to max_count.
+		[[nodiscard]] size_t count_ready_slots(const uint64_t position, const uint64_t offset,
+												const size_t max_count) const noexcept {
+			size_t count = 0;
+			while (count < max_count && sequences_[(position + count) & mask_].load(std::memory_order_acquire) ==
+				position + offset + count) {
+				++count;
+			}
+			return count;
+		}
+
+		// Claim up to max_count slots whose sequence numbers are position + offset + i by one compare and exchange.
+		size_t claim(std::atomic<uint64_t>& next_position, const uint64_t offset, const size_t max_count,
+					uint64_t& position) noexcept {
+			position = next_position.load(std::memory_order_relaxed);
+			while (true) {
+				const auto count = count_ready_slots(position, offset, std::min(max_count, capacity_));
+				if (count == 0) {
+					// The first slot is not ready because the queue is full or empty, or other threads moved the position.
+					const auto current = next_position.load(std::memory_order_relaxed);
+					if (current == position) {
+						return 0;
+					}
+					position = current;
+					continue;
+				}
+				if (next_position.compare_exchange_weak(position, position + count, std::memory_order_relaxed)) {
+					return count;
+				}
+			}
+		}
+
+		size_t try_push_batch_impl(const T* objects, const size_t max_count) {
+			uint64_t position;
+			const auto count = claim(enqueue_position_.value, 0, max_count, position);
+			// objects may be null for empty ranges, and memcpy must not be called with null even for 0 bytes.
+			if (count == 0) {
+				return 0;
+			}
+			// Serialize records in at most two contiguous segments because slots wrap around at the end.
+			const auto first = static_cast<size_t>(position & mask_);
+			const auto first_count = std::min(count, capacity_ - first);
+			serialize_array_impl<T, Order>(objects, first_count, slots_.get() + first * record_size);
+			if (count != first_count) {
+				serialize_array_impl<T, Order>(objects + first_count, count - first_count, slots_.get());
+			}
+			for (size_t i = 0; i < count; ++i) {
+				sequences_[(position + i) & mask_].store(position + i + 1, std::memory_order_release);
+			}
+			return count;
+		}
+
+		size_t try_pop_batch_impl(T* objects, const size_t max_count) {
+			uint64_t position;
+			const auto count = claim(dequeue_position_.value, 1, max_count, position);
+			// objects may be null for empty ranges, and memcpy must not be called with null even for 0 bytes.
+			if (count == 0) {
+				return 0;
+			}
+			const auto first = static_cast<size_t>(position & mask_);
+			const auto first_count = std::min(count, capacity_ - first);
+			deserialize_array_impl<T, Order>(objects, first_count, slots_.get() + first * record_size);
+			if (count != first_count) {
+				deserialize_array_impl<T, Order>(objects + first_count, count - first_count, slots_.get());
+			}
+			for (size_t i = 0; i < count; ++i) {
+				sequences_[(position + i) & mask_].store(position + i + capacity_, std::memory_order_release);
+			}
+			return count;
+		}
+	};
+}
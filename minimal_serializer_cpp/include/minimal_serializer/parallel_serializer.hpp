@@ -0,0 +1,270 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <numeric>
+
+#include "serializer.hpp"
+#include "thread_pool.hpp"
+
+namespace minimal_serializer {
+	/**
+	 * The approximate size of destination memory processed by a thread at once in parallel serialization.
+	 */
+	constexpr size_t parallel_chunk_size = 64 * 1024;
+
+	/**
+	 * @brief Division of contiguous elements into chunks whose boundaries are aligned to cache lines in destination memory if possible.
+	 */
+	class parallel_chunk_plan final {
+	public:
+		/**
+		 * @brief Divide elements into chunks.
+		 * @param destination The address of the first element in destination memory.
+		 * @param stride The size of each element in destination memory.
+		 * @param count The number of elements.
+		 */
+		parallel_chunk_plan(const void* destination, const size_t stride, const size_t count) : count_(count) {
+			// The number of elements whose total size is a multiple of cache line size.
+			const auto step = cache_line_size / std::gcd(stride, cache_line_size);
+			chunk_elements_ = std::max(step, parallel_chunk_size / stride / step * step);
+
+			// Make the first boundary aligned to cache line so that following boundaries are also aligned.
+			const auto address = reinterpret_cast<uintptr_t>(destination);
+			head_ = 0;
+			for (size_t i = 0; i < step; ++i) {
+				if ((address + i * stride) % cache_line_size == 0) {
+					head_ = i;
+					break;
+				}
+			}
+		}
+
+		/**
+		 * @brief Get the number of chunks.
+		 * @return The number of chunks.
+		 */
+		[[nodiscard]] size_t chunk_count() const noexcept {
+			if (count_ == 0) {
+				return 0;
+			}
+			const auto first_end = head_ + chunk_elements_;
+			return count_ <= first_end ? 1 : 1 + (count_ - first_end + chunk_elements_ - 1) / chunk_elements_;
+		}
+
+		/**
+		 * @brief Get the index of the first element in the chunk.
+		 * @param chunk_index The index of the chunk.
+		 * @return The index of the first element.
+		 */
+		[[nodiscard]] size_t begin(const size_t chunk_index) const noexcept {
+			return chunk_index == 0 ? 0 : std::min(count_, head_ + chunk_index * chunk_elements_);
+		}
+
+		/**
+		 * @brief Get the index next to the last element in the chunk.
+		 * @param chunk_index The index of the chunk.
+		 * @return The index next to the last element.
+		 */
+		[[nodiscard]] size_t end(const size_t chunk_index) const noexcept {
+			return std::min(count_, head_ + (chunk_index + 1) * chunk_elements_);
+		}
+
+	private:
+		size_t count_;
+		size_t chunk_elements_;
+		size_t head_;
+	};
+
+	/**
+	 * @brief Get the thread pool used in parallel serialization when a thread pool is not specified. The number of threads is same as hardware threads.
+	 * @return The default thread pool.
+	 */
+	inline thread_pool& get_default_thread_pool() {
+		static thread_pool pool;
+		return pool;
+	}
+
+	/**
+	 * Serialize contiguous objects to buffer back to back with multiple threads. The i-th object is written at offset + i * serialized_size_v<T>.
+	 *
+	 * @param objects A source range which has data() and size() member function such as std::vector<T> and std::span<const T>.
+	 * @param buffer A destination buffer which has data() and size() member function.
+	 * @param pool A thread pool which executes serialization.
+	 * @param offset A start position of the destination buffer.
+	 * @tparam Order The byte order of serialized data.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <byte_order Order, typename Range, typename Buffer>
+	auto serialize_range_parallel(Range&& objects, Buffer& buffer, thread_pool& pool,
+								size_t offset = 0) -> decltype(objects.data(), objects.size(),
+																std::declval<Buffer>().data(),
+																std::declval<Buffer>().size(), void()) {
+		using object_type = remove_cvref_t<decltype(*objects.data())>;
+		constexpr auto size = serialized_size_v<object_type>;
+		const auto count = static_cast<size_t>(objects.size());
+		if (!is_in_serialized_range<object_type>(buffer.size(), offset, count)) {
+			throw serialization_error("Serialization source is out of range.");
+		}
+
+		const auto* source = objects.data();
+		auto* data = buffer.data() + offset;
+		const parallel_chunk_plan plan(data, size, count);
+		pool.parallel_for(plan.chunk_count(), [&](const size_t chunk_index) {
+			const auto begin = plan.begin(chunk_index);
+			serialize_array_impl<object_type, Order>(source + begin, plan.end(chunk_index) - begin, data + begin * size);
+		});
+	}
+
+	/**
+	 * Serialize contiguous objects to buffer back to back in big endian with multiple threads. The i-th object is written at offset + i * serialized_size_v<T>.
+	 *
+	 * @param objects A source range which has data() and size() member function such as std::vector<T> and std::span<const T>.
+	 * @param buffer A destination buffer which has data() and size() member function.
+	 * @param pool A thread pool which executes serialization.
+	 * @param offset A start position of the destination buffer.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <typename Range, typename Buffer>
+	auto serialize_range_parallel(Range&& objects, Buffer& buffer, thread_pool& pool,
+								size_t offset = 0) -> decltype(objects.data(), objects.size(),
+																std::declval<Buffer>().data(),
+																std::declval<Buffer>().size(), void()) {
+		serialize_range_parallel<byte_order::big>(std::forward<Range>(objects), buffer, pool, offset);
+	}
+
+	/**
+	 * Serialize contiguous objects to buffer back to back with the default thread pool. The i-th object is written at offset + i * serialized_size_v<T>.
+	 *
+	 * @param objects A source range which has data() and size() member function such as std::vector<T> and std::span<const T>.
+	 * @param buffer A destination buffer which has data() and size() member function.
+	 * @param offset A start position of the destination buffer.
+	 * @tparam Order The byte order of serialized data.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <byte_order Order, typename Range, typename Buffer>
+	auto serialize_range_parallel(Range&& objects, Buffer& buffer,
+								size_t offset = 0) -> decltype(objects.data(), objects.size(),
+																std::declval<Buffer>().data(),
+																std::declval<Buffer>().size(), void()) {
+		serialize_range_parallel<Order>(std::forward<Range>(objects), buffer, get_default_thread_pool(), offset);
+	}
+
+	/**
+	 * Serialize contiguous objects to buffer back to back in big endian with the default thread pool. The i-th object is written at offset + i * serialized_size_v<T>.
+	 *
+	 * @param objects A source range which has data() and size() member function such as std::vector<T> and std::span<const T>.
+	 * @param buffer A destination buffer which has data() and size() member function.
+	 * @param offset A start position of the destination buffer.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <typename Range, typename Buffer>
+	auto serialize_range_parallel(Range&& objects, Buffer& buffer,
+								size_t offset = 0) -> decltype(objects.data(), objects.size(),
+																std::declval<Buffer>().data(),
+																std::declval<Buffer>().size(), void()) {
+		serialize_range_parallel<byte_order::big>(std::forward<Range>(objects), buffer, get_default_thread_pool(),
+												offset);
+	}
+
+	/**
+	 * Deserialize contiguous objects from buffer in which objects are serialized back to back with multiple threads. The i-th object is read from offset + i * serialized_size_v<T>.
+	 *
+	 * @param objects A destination range which has data() and size() member function such as std::vector<T> and std::span<T>.
+	 * @param buffer A source buffer which has data() and size() member function.
+	 * @param pool A thread pool which executes deserialization.
+	 * @param offset A start position of the source buffer.
+	 * @tparam Order The byte order of serialized data.
+	 * @throw serialization_error Deserialization is failed.
+	 */
+	template <byte_order Order, typename Range, typename Buffer>
+	auto deserialize_range_parallel(Range&& objects, const Buffer& buffer, thread_pool& pool,
+									size_t offset = 0) -> decltype(objects.data(), objects.size(),
+																	std::declval<Buffer>().data(),
+																	std::declval<Buffer>().size(),
+																	std::enable_if_t<!std::is_const_v<std::remove_reference_t<
+																		decltype(*objects.data())>>, void>()) {
+		using object_type = remove_cvref_t<decltype(*objects.data())>;
+		constexpr auto size = serialized_size_v<object_type>;
+		const auto count = static_cast<size_t>(objects.size());
+		if (!is_in_serialized_range<object_type>(buffer.size(), offset, count)) {
+			throw serialization_error("Deserialization destination is out of range.");
+		}
+
+		auto* destination = objects.data();
+		const auto* data = buffer.data() + offset;
+		// Objects are the destination in deserialization, so chunks are aligned in the memory of objects.
+		const parallel_chunk_plan plan(destination, sizeof(object_type), count);
+		pool.parallel_for(plan.chunk_count(), [&](const size_t chunk_index) {
+			const auto begin = plan.begin(chunk_index);
+			deserialize_array_impl<object_type, Order>(destination + begin, plan.end(chunk_index) - begin,
+														data + begin * size);
+		});
+	}
+
+	/**
+	 * Deserialize contiguous objects from buffer in which objects are serialized back to back in big endian with multiple threads. The i-th object is read from offset + i * serialized_size_v<T>.
+	 *
+	 * @param objects A destination range which has data() and size() member function such as std::vector<T> and std::span<T>.
+	 * @param buffer A source buffer which has data() and size() member function.
+	 * @param pool A thread pool which executes deserialization.
+	 * @param offset A start position of the source buffer.
+	 * @throw serialization_error Deserialization is failed.
+	 */
+	template <typename Range, typename Buffer>
+	auto deserialize_range_parallel(Range&& objects, const Buffer& buffer, thread_pool& pool,
+									size_t offset = 0) -> decltype(objects.data(), objects.size(),
+																	std::declval<Buffer>().data(),
+																	std::declval<Buffer>().size(),
+																	std::enable_if_t<!std::is_const_v<std::remove_reference_t<
+																		decltype(*objects.data())>>, void>()) {
+		deserialize_range_parallel<byte_order::big>(std::forward<Range>(objects), buffer, pool, offset);
+	}
+
+	/**
+	 * Deserialize contiguous objects from buffer in which objects are serialized back to back with the default thread pool. The i-th object is read from offset + i * serialized_size_v<T>.
+	 *
+	 * @param objects A destination range which has data() and size() member function such as std::vector<T> and std::span<T>.
+	 * @param buffer A source buffer which has data() and size() member function.
+	 * @param offset A start position of the source buffer.
+	 * @tparam Order The byte order of serialized data.
+	 * @throw serialization_error Deserialization is failed.
+	 */
+	template <byte_order Order, typename Range, typename Buffer>
+	auto deserialize_range_parallel(Range&& objects, const Buffer& buffer,
+									size_t offset = 0) -> decltype(objects.data(), objects.size(),
+																	std::declval<Buffer>().data(),
+																	std::declval<Buffer>().size(),
+																	std::enable_if_t<!std::is_const_v<std::remove_reference_t<
+																		decltype(*objects.data())>>, void>()) {
+		deserialize_range_parallel<Order>(std::forward<Range>(objects), buffer, get_default_thread_pool(), offset);
+	}
+
+	/**
+	 * Deserialize contiguous objects from buffer in which objects are serialized back to back in big endian with the default thread pool. The i-th object is read from offset + i * serialized_size_v<T>.
+	 *
+	 * @param objects A destination range which has data() and size() member function such as std::vector<T> and std::span<T>.
+	 * @param buffer A source buffer which has data() and size() member function.
+	 * @param offset A start position of the source buffer.
+	 * @throw serialization_error Deserialization is failed.
+	 */
+	template <typename Range, typename Buffer>
+	auto deserialize_range_parallel(Range&& objects, const Buffer& buffer,
+									size_t offset = 0) -> decltype(objects.data(), objects.size(),
+																	std::declval<Buffer>().data(),
+																	std::declval<Buffer>().size(),
+																	std::enable_if_t<!std::is_const_v<std::remove_reference_t<
+																		decltype(*objects.data())>>, void>()) {
+		deserialize_range_parallel<byte_order::big>(std::forward<Range>(objects), buffer, get_default_thread_pool(),
+													offset);
+	}
+}
@@ -0,0 +1,65 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+// File descriptor based features are available only in POSIX environments.
+#if __has_include(<unistd.h>) && __has_include(<sys/uio.h>)
+#define MINIMAL_SERIALIZER_POSIX_IO
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <system_error>
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace minimal_serializer {
+	/**
+	 * Throw std::system_error with the current errno.
+	 */
+	[[noreturn]] inline void throw_last_system_error(const char* message) {
+		throw std::system_error(errno, std::generic_category(), message);
+	}
+
+	/**
+	 * Write all data indicated by iovecs to a file descriptor. Partial writes and interruptions by signals are retried. The iovecs are modified.
+	 * @param fd A destination file descriptor.
+	 * @param iov An array of iovecs.
+	 * @param count The number of iovecs.
+	 * @throw std::system_error Writing is failed.
+	 */
+	inline void write_all(const int fd, iovec* iov, int count) {
+		while (count > 0) {
+			const auto written = ::writev(fd, iov, std::min(count, IOV_MAX));
+			if (written < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				throw_last_system_error("Failed to write to the file descriptor.");
+			}
+
+			// Skip iovecs which are written completely and advance the first one which is written partially.
+			auto rest = static_cast<size_t>(written);
+			while (count > 0 && rest >= iov->iov_len) {
+				rest -= iov->iov_len;
+				++iov;
+				--count;
+			}
+			if (count > 0) {
+				iov->iov_base = static_cast<uint8_t*>(iov->iov_base) + rest;
+				iov->iov_len -= rest;
+			}
+		}
+	}
+}
+#endif
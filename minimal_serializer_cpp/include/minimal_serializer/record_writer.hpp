@@ -0,0 +1,246 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "posix_io.hpp"
+
+#ifdef MINIMAL_SERIALIZER_POSIX_IO
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <new>
+
+#include "serializer.hpp"
+
+namespace minimal_serializer {
+	/**
+	 * When record_writer synchronizes written data to the storage device by fsync.
+	 */
+	enum class fsync_policy {
+		// Never call fsync automatically.
+		never,
+		// Call fsync after each batch of records is written.
+		per_batch,
+		// Call fsync after a batch is written if the sync interval passed since the last fsync.
+		interval,
+	};
+
+	/**
+	 * Options of record_writer.
+	 */
+	struct record_writer_options final {
+		// The capacity of the staging buffer in bytes. This is rounded up to a multiple of the serialized size of records.
+		size_t buffer_size = 1 << 20;
+		// Staged records are written when the staged size reaches this. 0 means the capacity of the staging buffer.
+		size_t flush_threshold = 0;
+		fsync_policy sync = fsync_policy::never;
+		std::chrono::steady_clock::duration sync_interval = std::chrono::seconds(1);
+	};
+
+	/**
+	 * @brief A writer which serializes records into a staging buffer and writes them to a file descriptor in batches to reduce system calls.
+	 * Staged records are written when the staged size reaches the flush threshold, flush() is called or the writer is destroyed.
+	 * The file descriptor is not closed by the writer.
+	 * @tparam T The type of records.
+	 * @tparam Order The byte order of serialized data.
+	 */
+	template <typename T, byte_order Order = byte_order::big>
+	class record_writer final {
+	public:
+		/**
+		 * The serialized size of a record.
+		 */
+		static constexpr size_t record_size = serialized_size_v<T, Order>;
+
+		/**
+		 * The alignment of the staging buffer, which is same as a common page size.
+		 */
+		static constexpr size_t buffer_alignment = 4096;
+
+		/**
+		 * @brief Create a writer.
+		 * @param fd A destination file descriptor.
+		 * @param options Options of the writer.
+		 */
+		explicit record_writer(const int fd, const record_writer_options& options = {}) : fd_(fd),
+			capacity_(std::max<size_t>((options.buffer_size + record_size - 1) / record_size, 1) * record_size),
+			threshold_(options.flush_threshold == 0 ? capacity_ : std::min(options.flush_threshold, capacity_)),
+			sync_policy_(options.sync), sync_interval_(options.sync_interval),
+			last_sync_time_(std::chrono::steady_clock::now()),
+			buffer_(static_cast<uint8_t*>(::operator new(capacity_, std::align_val_t(buffer_alignment)))) {}
+
+		record_writer(const record_writer&) = delete;
+		record_writer(record_writer&&) = delete;
+
+		/**
+		 * @brief Write staged records. Errors are ignored, so call flush() before destruction to handle them.
+		 */
+		~record_writer() {
+			try {
+				flush();
+			}
+			catch (...) {}
+		}
+
+		record_writer& operator=(const record_writer&) = delete;
+		record_writer& operator=(record_writer&&) = delete;
+
+		/**
+		 * @brief Serialize a record into the staging buffer.
+		 * @param obj A record to write.
+		 * @throw std::system_error Writing staged records is failed.
+		 */
+		void write(const T& obj) {
+			if (capacity_ - size_ < record_size) {
+				flush();
+			}
+			serialize_impl<T, Order>(obj, buffer_.get() + size_);
+			size_ += record_size;
+			if (size_ >= threshold_) {
+				flush();
+			}
+		}
+
+		/**
+		 * @brief Serialize contiguous records into the staging buffer.
+		 * @param objects A source range which has data() and size() member function such as std::vector<T> and std::span<const T>.
+		 * @throw std::system_error Writing staged records is failed.
+		 */
+		template <typename Range>
+		auto write_range(Range&& objects) -> decltype(objects.data(), objects.size(), void()) {
+			static_assert(std::is_same_v<remove_cvref_t<decltype(*objects.data())>, T>, "Elements of the range must be T.");
+			const T* source = objects.data();
+			auto count = static_cast<size_t>(objects.size());
+			while (count > 0) {
+				const auto staged_count = std::min(count, (capacity_ - size_) / record_size);
+				if (staged_count == 0) {
+					flush();
+					continue;
+				}
+				serialize_array_impl<T, Order>(source, staged_count, buffer_.get() + size_);
+				size_ += staged_count * record_size;
+				source += staged_count;
+				count -= staged_count;
+				if (size_ >= threshold_) {
+					flush();
+				}
+			}
+		}
+
+		/**
+		 * @brief Write records which are already serialized. Data larger than the free space of the staging buffer is written together with staged records by writev without copying.
+		 * @param data A source buffer which has data() and size() member function. The size must be a multiple of record_size.
+		 * @throw serialization_error The size of data is not a multiple of record_size.
+		 * @throw std::system_error Writing is failed.
+		 */
+		template <typename Buffer>
+		auto write_serialized(const Buffer& data) -> decltype(data.data(), data.size(), void()) {
+			const auto data_size = static_cast<size_t>(data.size());
+			if (data_size % record_size != 0) {
+				throw serialization_error("The size of serialized data must be a multiple of the serialized size of records.");
+			}
+
+			if (data_size <= capacity_ - size_) {
+				std::memcpy(buffer_.get() + size_, data.data(), data_size);
+				size_ += data_size;
+				if (size_ >= threshold_) {
+					flush();
+				}
+				return;
+			}
+
+			iovec iov[2] = {
+				{buffer_.get(), size_},
+				{const_cast<uint8_t*>(reinterpret_cast<const uint8_t*>(data.data())), data_size},
+			};
+			// Staged records are discarded even if writing is failed because it is unknown how many bytes are written.
+			size_ = 0;
+			write_all(fd_, iov, 2);
+			on_batch_written();
+		}
+
+		/**
+		 * @brief Write all staged records to the file descriptor.
+		 * @throw std::system_error Writing is failed.
+		 */
+		void flush() {
+			if (size_ == 0) {
+				return;
+			}
+
+			iovec iov{buffer_.get(), size_};
+			// Staged records are discarded even if writing is failed because it is unknown how many bytes are written.
+			size_ = 0;
+			write_all(fd_, &iov, 1);
+			on_batch_written();
+		}
+
+		/**
+		 * @brief Synchronize written data to the storage device by fsync. Staged records are not written.
+		 * @throw std::system_error fsync is failed.
+		 */
+		void sync() {
+			if (::fsync(fd_) != 0) {
+				throw_last_system_error("Failed to synchronize the file descriptor.");
+			}
+			last_sync_time_ = std::chrono::steady_clock::now();
+		}
+
+		/**
+		 * @brief Get the size of staged records which are not written yet.
+		 * @return The staged size in bytes.
+		 */
+		[[nodiscard]] size_t buffered_size() const noexcept {
+			return size_;
+		}
+
+		/**
+		 * @brief Get the capacity of the staging buffer.
+		 * @return The capacity in bytes.
+		 */
+		[[nodiscard]] size_t capacity() const noexcept {
+			return capacity_;
+		}
+
+		/**
+		 * @brief Get the destination file descriptor.
+		 * @return The file descriptor.
+		 */
+		[[nodiscard]] int fd() const noexcept {
+			return fd_;
+		}
+
+	private:
+		struct aligned_deleter final {
+			void operator()(uint8_t* ptr) const noexcept {
+				::operator delete(ptr, std::align_val_t(buffer_alignment));
+			}
+		};
+
+		int fd_;
+		size_t capacity_;
+		size_t threshold_;
+		fsync_policy sync_policy_;
+		std::chrono::steady_clock::duration sync_interval_;
+		std::chrono::steady_clock::time_point last_sync_time_;
+		std::unique_ptr<uint8_t[], aligned_deleter> buffer_;
+		size_t size_ = 0;
+
+		void on_batch_written() {
+			if (sync_policy_ == fsync_policy::per_batch ||
+				(sync_policy_ == fsync_policy::interval &&
+					std::chrono::steady_clock::now() - last_sync_time_ >= sync_interval_)) {
+				sync();
+			}
+		}
+	};
+}
+#endif
@@ -0,0 +1,326 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+
+#include "posix_io.hpp"
+#include "serializer.hpp"
+
+namespace minimal_serializer {
+	/**
+	 * Get the size of a segment which has size() member function.
+	 */
+	template <typename Segment>
+	auto get_segment_size(const Segment& segment) -> decltype(static_cast<size_t>(segment.size())) {
+		return static_cast<size_t>(segment.size());
+	}
+
+	/**
+	 * Get the pointer to the bytes of a segment which has data() member function.
+	 */
+	template <typename Segment>
+	auto get_segment_data(Segment& segment) -> decltype(reinterpret_cast<uint8_t*>(segment.data())) {
+		return reinterpret_cast<uint8_t*>(segment.data());
+	}
+
+	/**
+	 * Get the pointer to the bytes of a read only segment which has data() member function.
+	 */
+	template <typename Segment>
+	auto get_segment_data(const Segment& segment) -> decltype(reinterpret_cast<const uint8_t*>(segment.data())) {
+		return reinterpret_cast<const uint8_t*>(segment.data());
+	}
+
+#ifdef MINIMAL_SERIALIZER_POSIX_IO
+	/**
+	 * Get the size of iovec.
+	 */
+	inline size_t get_segment_size(const iovec& segment) {
+		return segment.iov_len;
+	}
+
+	/**
+	 * Get the pointer to the bytes of iovec.
+	 */
+	inline uint8_t* get_segment_data(const iovec& segment) {
+		return static_cast<uint8_t*>(segment.iov_base);
+	}
+#endif
+
+	/**
+	 * @brief A position in a sequence of segments which are regarded as one contiguous byte sequence. Empty segments are skipped.
+	 * @tparam Iterator An iterator of segments.
+	 * @tparam Pointer uint8_t* for writing or const uint8_t* for reading.
+	 */
+	template <typename Iterator, typename Pointer>
+	class segment_cursor final {
+	public:
+		segment_cursor(Iterator begin, Iterator end, size_t offset) : it_(begin), end_(end) {
+			for (; it_ != end_; ++it_) {
+				const auto size = get_segment_size(*it_);
+				if (offset < size) {
+					data_ = get_segment_data(*it_) + offset;
+					remaining_ = size - offset;
+					return;
+				}
+				offset -= size;
+			}
+		}
+
+		/**
+		 * @brief Get the pointer to the current position.
+		 */
+		[[nodiscard]] Pointer data() const noexcept {
+			return data_;
+		}
+
+		/**
+		 * @brief Get the number of bytes from the current position to the end of the current segment.
+		 */
+		[[nodiscard]] size_t remaining() const noexcept {
+			return remaining_;
+		}
+
+		/**
+		 * @brief Advance the position in the current segment, and move to the next non empty segment if the current one ends.
+		 */
+		void advance(const size_t size) noexcept {
+			data_ += size;
+			remaining_ -= size;
+			while (remaining_ == 0 && it_ != end_ && ++it_ != end_) {
+				data_ = get_segment_data(*it_);
+				remaining_ = get_segment_size(*it_);
+			}
+		}
+
+		/**
+		 * @brief Copy bytes to segments across their boundaries.
+		 */
+		void write(const uint8_t* source, size_t size) noexcept {
+			while (size > 0) {
+				const auto copy_size = std::min(size, remaining_);
+				std::memcpy(data_, source, copy_size);
+				source += copy_size;
+				size -= copy_size;
+				advance(copy_size);
+			}
+		}
+
+		/**
+		 * @brief Copy bytes from segments across their boundaries.
+		 */
+		void read(uint8_t* destination, size_t size) noexcept {
+			while (size > 0) {
+				const auto copy_size = std::min(size, remaining_);
+				std::memcpy(destination, data_, copy_size);
+				destination += copy_size;
+				size -= copy_size;
+				advance(copy_size);
+			}
+		}
+
+	private:
+		Iterator it_;
+		Iterator end_;
+		Pointer data_ = nullptr;
+		size_t remaining_ = 0;
+	};
+
+	/**
+	 * Get the total size of segments.
+	 */
+	template <typename Segments>
+	size_t get_segments_size(Segments& segments) {
+		size_t size = 0;
+		for (auto&& segment : segments) {
+			size += get_segment_size(segment);
+		}
+		return size;
+	}
+
+	template <typename T, byte_order Order, typename Cursor>
+	void serialize_scatter_impl(const T& obj, Cursor& cursor);
+
+	template <typename T, byte_order Order, typename Cursor, size_t... Is>
+	void serialize_scatter_tuple_impl(const T& obj, Cursor& cursor, std::index_sequence<Is...>) {
+		(serialize_scatter_impl<remove_cvref_t<std::tuple_element_t<Is, T>>, Order>(std::get<Is>(obj), cursor), ...);
+	}
+
+	/**
+	 * Serialize data to segments. Data is written directly if it fits in the current segment, and only leaves across segment boundaries are split.
+	 */
+	template <typename T, byte_order Order, typename Cursor>
+	void serialize_scatter_impl(const T& obj, Cursor& cursor) {
+		constexpr auto size = serialized_size_v<T>;
+		if (size <= cursor.remaining()) {
+			serialize_impl<T, Order>(obj, cursor.data());
+			cursor.advance(size);
+		}
+		else if constexpr (is_std_array_v<T>) {
+			// Serialize elements which fit in the current segment at once.
+			using element_type = typename T::value_type;
+			constexpr auto element_size = serialized_size_v<element_type>;
+			for (size_t i = 0; i < obj.size();) {
+				const auto count = std::min(obj.size() - i, cursor.remaining() / element_size);
+				if (count == 0) {
+					serialize_scatter_impl<element_type, Order>(obj[i], cursor);
+					++i;
+					continue;
+				}
+				serialize_array_impl<element_type, Order>(obj.data() + i, count, cursor.data());
+				cursor.advance(count * element_size);
+				i += count;
+			}
+		}
+		else if constexpr (is_serializable_tuple_v<T>) {
+			serialize_scatter_tuple_impl<T, Order>(obj, cursor, std::make_index_sequence<std::tuple_size_v<T>>{});
+		}
+		else if constexpr (is_serializable_custom_type_v<T> && !is_bit_packed_v<T>) {
+			using target_types = typename serialize_targets_t<T>::const_reference_types;
+			serialize_scatter_tuple_impl<target_types, Order>(serialize_targets_t<T>::get_const_reference_tuple(obj),
+															cursor,
+															std::make_index_sequence<std::tuple_size_v<target_types>>{});
+		}
+		else {
+			// Split a leaf or a bit packed custom type across segments via a temporary buffer.
+			serialized_data<T, Order> data;
+			serialize_impl<T, Order>(obj, data.data());
+			cursor.write(data.data(), data.size());
+		}
+	}
+
+	/**
+	 * Serialize data to a sequence of segments which are regarded as one contiguous buffer.
+	 *
+	 * @param obj A object to serialize.
+	 * @param segments A range of segments. Each segment has data() and size() member function, or is iovec in POSIX environments.
+	 * @param offset A start position in the segments.
+	 * @tparam Order The byte order of serialized data.
+	 * @tparam T The type of data to serialize.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <byte_order Order, typename T, typename Segments>
+	auto serialize_scatter(const T& obj, Segments&& segments, size_t offset = 0) -> decltype(
+		std::begin(segments), std::end(segments), void()) {
+		if (!is_in_serialized_range<T>(get_segments_size(segments), offset)) {
+			throw serialization_error("Serialization source is out of range.");
+		}
+
+		segment_cursor<decltype(std::begin(segments)), uint8_t*> cursor(std::begin(segments), std::end(segments), offset);
+		serialize_scatter_impl<T, Order>(obj, cursor);
+	}
+
+	/**
+	 * Serialize data to a sequence of segments which are regarded as one contiguous buffer in big endian.
+	 *
+	 * @param obj A object to serialize.
+	 * @param segments A range of segments. Each segment has data() and size() member function, or is iovec in POSIX environments.
+	 * @param offset A start position in the segments.
+	 * @tparam T The type of data to serialize.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <typename T, typename Segments>
+	auto serialize_scatter(const T& obj, Segments&& segments, size_t offset = 0) -> decltype(
+		std::begin(segments), std::end(segments), void()) {
+		serialize_scatter<byte_order::big>(obj, std::forward<Segments>(segments), offset);
+	}
+
+	template <typename T, byte_order Order, typename Cursor>
+	void deserialize_gather_impl(T& obj, Cursor& cursor);
+
+	template <typename T, byte_order Order, typename Cursor, size_t... Is>
+	void deserialize_gather_tuple_impl(T& obj, Cursor& cursor, std::index_sequence<Is...>) {
+		(deserialize_gather_impl<remove_cvref_t<std::tuple_element_t<Is, T>>, Order>(std::get<Is>(obj), cursor), ...);
+	}
+
+	/**
+	 * Deserialize data from segments. Data is read directly if it is in the current segment, and only leaves across segment boundaries are copied.
+	 */
+	template <typename T, byte_order Order, typename Cursor>
+	void deserialize_gather_impl(T& obj, Cursor& cursor) {
+		constexpr auto size = serialized_size_v<T>;
+		if (size <= cursor.remaining()) {
+			deserialize_impl<T, Order>(obj, cursor.data());
+			cursor.advance(size);
+		}
+		else if constexpr (is_std_array_v<T>) {
+			// Deserialize elements which are in the current segment at once.
+			using element_type = typename T::value_type;
+			constexpr auto element_size = serialized_size_v<element_type>;
+			for (size_t i = 0; i < obj.size();) {
+				const auto count = std::min(obj.size() - i, cursor.remaining() / element_size);
+				if (count == 0) {
+					deserialize_gather_impl<element_type, Order>(obj[i], cursor);
+					++i;
+					continue;
+				}
+				deserialize_array_impl<element_type, Order>(obj.data() + i, count, cursor.data());
+				cursor.advance(count * element_size);
+				i += count;
+			}
+		}
+		else if constexpr (is_serializable_tuple_v<T>) {
+			deserialize_gather_tuple_impl<T, Order>(obj, cursor, std::make_index_sequence<std::tuple_size_v<T>>{});
+		}
+		else if constexpr (is_serializable_custom_type_v<T> && !is_bit_packed_v<T>) {
+			using target_types = typename serialize_targets_t<T>::reference_types;
+			auto target_references = serialize_targets_t<T>::get_reference_tuple(obj);
+			deserialize_gather_tuple_impl<target_types, Order>(target_references, cursor,
+																std::make_index_sequence<std::tuple_size_v<
+																	target_types>>{});
+		}
+		else {
+			// Gather a leaf or a bit packed custom type across segments via a temporary buffer.
+			serialized_data<T, Order> data;
+			cursor.read(data.data(), data.size());
+			deserialize_impl<T, Order>(obj, data.data());
+		}
+	}
+
+	/**
+	 * Deserialize data from a sequence of segments which are regarded as one contiguous buffer.
+	 *
+	 * @param obj A object to deserialize.
+	 * @param segments A range of segments. Each segment has data() and size() member function, or is iovec in POSIX environments.
+	 * @param offset A start position in the segments.
+	 * @tparam Order The byte order of serialized data.
+	 * @tparam T The type of data to deserialize.
+	 * @throw serialization_error Deserialization is failed.
+	 */
+	template <byte_order Order, typename T, typename Segments>
+	auto deserialize_gather(T& obj, Segments&& segments, size_t offset = 0) -> decltype(
+		std::begin(segments), std::end(segments), std::enable_if_t<!std::is_const_v<T>, void>()) {
+		if (!is_in_serialized_range<T>(get_segments_size(segments), offset)) {
+			throw serialization_error("Deserialization destination is out of range.");
+		}
+
+		segment_cursor<decltype(std::begin(segments)), const uint8_t*> cursor(std::begin(segments),
+																			std::end(segments), offset);
+		deserialize_gather_impl<T, Order>(obj, cursor);
+	}
+
+	/**
+	 * Deserialize data from a sequence of segments which are regarded as one contiguous buffer in big endian.
+	 *
+	 * @param obj A object to deserialize.
+	 * @param segments A range of segments. Each segment has data() and size() member function, or is iovec in POSIX environments.
+	 * @param offset A start position in the segments.
+	 * @tparam T The type of data to deserialize.
+	 * @throw serialization_error Deserialization is failed.
+	 */
+	template <typename T, typename Segments>
+	auto deserialize_gather(T& obj, Segments&& segments, size_t offset = 0) -> decltype(
+		std::begin(segments), std::end(segments), std::enable_if_t<!std::is_const_v<T>, void>()) {
+		deserialize_gather<byte_order::big>(obj, std::forward<Segments>(segments), offset);
+	}
+}
@@ -0,0 +1,372 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "nameof.hpp"
+#include "serializer.hpp"
+#include "sink_source.hpp"
+
+namespace minimal_serializer {
+	/**
+	 * Kinds of nodes in the schema which are hashed into schema fingerprints.
+	 */
+	enum class schema_kind : uint8_t {
+		boolean,
+		signed_integer,
+		unsigned_integer,
+		floating_point,
+		enumeration,
+		array,
+		tuple,
+		string,
+		custom,
+		bit_packed_custom,
+		character,
+	};
+
+	/**
+	 * Get the kind of an arithmetic type. Character types are distinguished only by their sizes because the signedness of char and wchar_t depends on platforms.
+	 */
+	template <typename T>
+	constexpr schema_kind get_schema_kind() noexcept {
+		if constexpr (std::is_same_v<T, bool>) {
+			return schema_kind::boolean;
+		}
+		else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, wchar_t> || std::is_same_v<T, char16_t> ||
+			std::is_same_v<T, char32_t>
+#if __cpp_char8_t
+			|| std::is_same_v<T, char8_t>
+#endif
+		) {
+			return schema_kind::character;
+		}
+		else if constexpr (std::is_floating_point_v<T>) {
+			return schema_kind::floating_point;
+		}
+		else if constexpr (std::is_signed_v<T>) {
+			return schema_kind::signed_integer;
+		}
+		else {
+			return schema_kind::unsigned_integer;
+		}
+	}
+
+	constexpr uint64_t schema_fingerprint_offset_basis = 0xcbf29ce484222325;
+	constexpr uint64_t schema_fingerprint_prime = 0x100000001b3;
+
+	/**
+	 * Hash a value into a schema fingerprint by 64 bit FNV-1a for each byte from the lowest.
+	 */
+	constexpr uint64_t hash_schema_value(uint64_t hash, const uint64_t value) noexcept {
+		for (size_t i = 0; i < sizeof(value); ++i) {
+			hash = (hash ^ (value >> i * 8 & 0xff)) * schema_fingerprint_prime;
+		}
+		return hash;
+	}
+
+	/**
+	 * Hash a name into a schema fingerprint with its length first to separate consecutive names.
+	 */
+	constexpr uint64_t hash_schema_name(uint64_t hash, const std::string_view name) noexcept {
+		hash = hash_schema_value(hash, name.size());
+		for (const auto c : name) {
+			hash = (hash ^ static_cast<uint8_t>(c)) * schema_fingerprint_prime;
+		}
+		return hash;
+	}
+
+	template <typename Targets>
+	struct serialize_target_names;
+
+	template <auto... Ptrs>
+	struct serialize_target_names<serialize_target_container<Ptrs...>> {
+#if NAMEOF_MEMBER_SUPPORTED
+		static constexpr std::array<std::string_view, sizeof...(Ptrs)> names{nameof::nameof_member<Ptrs>()...};
+#endif
+	};
+
+	template <typename T, bool Named>
+	constexpr uint64_t get_schema_fingerprint_impl(uint64_t hash);
+
+	template <typename T, bool Named, size_t... Is>
+	constexpr uint64_t get_schema_fingerprint_tuple_impl(uint64_t hash, std::index_sequence<Is...>) {
+		((hash = get_schema_fingerprint_impl<remove_cvref_t<std::tuple_element_t<Is, T>>, Named>(hash)), ...);
+		return hash;
+	}
+
+	template <typename T, bool Named, size_t I>
+	constexpr uint64_t hash_schema_target(uint64_t hash, const std::string_view name) {
+		using target_type = remove_cvref_t<std::tuple_element_t<I, typename serialize_targets_t<T>::types>>;
+		hash = hash_schema_value(hash, is_bit_packed_v<T> ? serialized_bit_width_v<target_type> : 0);
+		if constexpr (Named) {
+			hash = hash_schema_name(hash, name);
+		}
+		return get_schema_fingerprint_impl<target_type, Named>(hash);
+	}
+
+	template <typename T, bool Named, size_t... Is>
+	constexpr uint64_t get_schema_fingerprint_custom_impl(uint64_t hash, std::index_sequence<Is...>) {
+#if NAMEOF_MEMBER_SUPPORTED
+		constexpr auto& names = serialize_target_names<serialize_targets_t<T>>::names;
+#else
+		constexpr std::array<std::string_view, sizeof...(Is)> names{};
+#endif
+		((hash = hash_schema_target<T, Named, Is>(hash, names[Is])), ...);
+		return hash;
+	}
+
+	template <typename T, bool Named>
+	constexpr uint64_t get_schema_fingerprint_impl(uint64_t hash) {
+		if constexpr (is_serializable_builtin_type_v<T>) {
+			hash = hash_schema_value(hash, static_cast<uint64_t>(get_schema_kind<T>()));
+			return hash_schema_value(hash, sizeof(T));
+		}
+		else if constexpr (is_serializable_enum_v<T>) {
+			hash = hash_schema_value(hash, static_cast<uint64_t>(schema_kind::enumeration));
+			return get_schema_fingerprint_impl<std::underlying_type_t<T>, Named>(hash);
+		}
+		else if constexpr (is_std_array_v<T>) {
+			hash = hash_schema_value(hash, static_cast<uint64_t>(schema_kind::array));
+			hash = hash_schema_value(hash, std::tuple_size_v<T>);
+			return get_schema_fingerprint_impl<typename T::value_type, Named>(hash);
+		}
+		else if constexpr (is_serializable_tuple_v<T>) {
+			hash = hash_schema_value(hash, static_cast<uint64_t>(schema_kind::tuple));
+			hash = hash_schema_value(hash, std::tuple_size_v<T>);
+			return get_schema_fingerprint_tuple_impl<T, Named>(hash, std::make_index_sequence<std::tuple_size_v<T>>{});
+		}
+		else if constexpr (is_serializable_boost_static_string_v<T>) {
+			hash = hash_schema_value(hash, static_cast<uint64_t>(schema_kind::string));
+			return hash_schema_value(hash, T::static_capacity);
+		}
+		else if constexpr (is_serializable_custom_type_v<T>) {
+			using target_types = typename serialize_targets_t<T>::types;
+			constexpr auto count = std::tuple_size_v<target_types>;
+			hash = hash_schema_value(hash, static_cast<uint64_t>(is_bit_packed_v<T> ? schema_kind::bit_packed_custom : schema_kind::custom));
+			hash = hash_schema_value(hash, count);
+			return get_schema_fingerprint_custom_impl<T, Named>(hash, std::make_index_sequence<count>{});
+		}
+		else {
+			static_assertion_for_not_serializable_type<T>();
+			return 0;
+		}
+	}
+
+	/**
+	 * A 64 bit hash of the schema of T, which consists of kinds and sizes of values, lengths of arrays, the order and nesting of tuples and serialize targets, and bit widths of bit packed types.
+	 * This is calculated in compile time and same on all compilers and platforms. Names of types and members are not included.
+	 * If T has const, volatile and/or reference, they will be removed.
+	 */
+	template <typename T>
+	constexpr uint64_t schema_fingerprint_v = get_schema_fingerprint_impl<remove_cvref_t<T>, false>(schema_fingerprint_offset_basis);
+
+#if NAMEOF_MEMBER_SUPPORTED
+	/**
+	 * A 64 bit hash of the schema of T which also includes names of serialize targets, to detect renamed or swapped members of the same type.
+	 * This is available only on compilers which nameof supports names of members, and names may differ between compilers.
+	 * If T has const, volatile and/or reference, they will be removed.
+	 */
+	template <typename T>
+	constexpr uint64_t named_schema_fingerprint_v = get_schema_fingerprint_impl<remove_cvref_t<T>, true>(schema_fingerprint_offset_basis);
+#endif
+
+	/**
+	 * Get schema_fingerprint_v<T>, or named_schema_fingerprint_v<T> if Named is true.
+	 */
+	template <typename T, bool Named>
+	constexpr uint64_t get_schema_fingerprint() noexcept {
+		if constexpr (Named) {
+#if NAMEOF_MEMBER_SUPPORTED
+			return named_schema_fingerprint_v<T>;
+#else
+			static_assert(!Named, "Named schema fingerprints are not supported in this compiler.");
+			return 0;
+#endif
+		}
+		else {
+			return schema_fingerprint_v<T>;
+		}
+	}
+
+	/**
+	 * The size of a schema fingerprint put before serialized data.
+	 */
+	constexpr size_t schema_fingerprint_size = sizeof(uint64_t);
+
+	/**
+	 * The size of serialized data of T with the schema fingerprint.
+	 */
+	template <typename T, byte_order Order = byte_order::big>
+	constexpr size_t fingerprinted_serialized_size_v = schema_fingerprint_size + serialized_size_v<T, Order>;
+
+	/**
+	 * A fixed size byte array of serialized data of T with the schema fingerprint.
+	 */
+	template <typename T, byte_order Order = byte_order::big>
+	using fingerprinted_serialized_data = std::array<uint8_t, fingerprinted_serialized_size_v<T, Order>>;
+
+	/**
+	 * Serialize the schema fingerprint in Order followed by data to the position which is already checked to have enough space.
+	 */
+	template <typename T, byte_order Order, bool Named>
+	void serialize_fingerprinted_impl(const T& obj, uint8_t* data) {
+		serialize_impl<uint64_t, Order>(get_schema_fingerprint<T, Named>(), data);
+		serialize_impl<T, Order>(obj, data + schema_fingerprint_size);
+	}
+
+	/**
+	 * Serialize data with the schema fingerprint to size fixed byte array.
+	 *
+	 * @param obj A object to serialize.
+	 * @tparam Order The byte order of serialized data and the fingerprint.
+	 * @tparam Named Whether to use named_schema_fingerprint_v, which is available only if NAMEOF_MEMBER_SUPPORTED is true.
+	 * @tparam T The type of data to serialize.
+	 * @return The fingerprint followed by serialized data.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <byte_order Order, bool Named = false, typename T>
+	fingerprinted_serialized_data<T, Order> serialize_fingerprinted(const T& obj) {
+		fingerprinted_serialized_data<T, Order> data;
+		serialize_fingerprinted_impl<T, Order, Named>(obj, data.data());
+		return data;
+	}
+
+	/**
+	 * Serialize data with the schema fingerprint to size fixed byte array in big endian.
+	 *
+	 * @param obj A object to serialize.
+	 * @tparam T The type of data to serialize.
+	 * @return The fingerprint followed by serialized data.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <typename T>
+	fingerprinted_serialized_data<T> serialize_fingerprinted(const T& obj) {
+		return serialize_fingerprinted<byte_order::big>(obj);
+	}
+
+	/**
+	 * Serialize data with the schema fingerprint to buffer.
+	 *
+	 * @param obj A object to serialize.
+	 * @param buffer A destination buffer which has data() and size() member function.
+	 * @param offset A start position of the buffer.
+	 * @tparam Order The byte order of serialized data and the fingerprint.
+	 * @tparam Named Whether to use named_schema_fingerprint_v, which is available only if NAMEOF_MEMBER_SUPPORTED is true.
+	 * @tparam T The type of data to serialize.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <byte_order Order, bool Named = false, typename T, typename Buffer>
+	auto serialize_fingerprinted(const T& obj, Buffer& buffer, const size_t offset = 0) -> decltype(
+		std::declval<Buffer>().data(), std::declval<Buffer>().size(), void()) {
+		if (offset > buffer.size() || buffer.size() - offset < fingerprinted_serialized_size_v<T, Order>) {
+			throw serialization_error("Serialization source is out of range.");
+		}
+		serialize_fingerprinted_impl<T, Order, Named>(obj, buffer.data() + offset);
+	}
+
+	/**
+	 * Serialize data with the schema fingerprint to buffer in big endian.
+	 *
+	 * @param obj A object to serialize.
+	 * @param buffer A destination buffer which has data() and size() member function.
+	 * @param offset A start position of the buffer.
+	 * @tparam T The type of data to serialize.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <typename T, typename Buffer>
+	auto serialize_fingerprinted(const T& obj, Buffer& buffer, const size_t offset = 0) -> decltype(
+		std::declval<Buffer>().data(), std::declval<Buffer>().size(), void()) {
+		serialize_fingerprinted<byte_order::big>(obj, buffer, offset);
+	}
+
+	/**
+	 * Serialize data with the schema fingerprint to sink.
+	 *
+	 * @param obj A object to serialize.
+	 * @param sink A destination sink which satisfies is_serialization_sink_v.
+	 * @tparam Order The byte order of serialized data and the fingerprint.
+	 * @tparam Named Whether to use named_schema_fingerprint_v, which is available only if NAMEOF_MEMBER_SUPPORTED is true.
+	 * @tparam T The type of data to serialize.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <byte_order Order, bool Named = false, typename T, typename Sink>
+	auto serialize_fingerprinted(const T& obj, Sink& sink) -> std::enable_if_t<is_serialization_sink_v<Sink>> {
+		constexpr auto size = fingerprinted_serialized_size_v<T, Order>;
+		const auto data = sink.reserve(size);
+		if (data == nullptr) {
+			throw serialization_error("Serialization source is out of range.");
+		}
+		serialize_fingerprinted_impl<T, Order, Named>(obj, data);
+		sink.commit(size);
+	}
+
+	/**
+	 * Serialize data with the schema fingerprint to sink in big endian.
+	 *
+	 * @param obj A object to serialize.
+	 * @param sink A destination sink which satisfies is_serialization_sink_v.
+	 * @tparam T The type of data to serialize.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <typename T, typename Sink>
+	auto serialize_fingerprinted(const T& obj, Sink& sink) -> std::enable_if_t<is_serialization_sink_v<Sink>> {
+		serialize_fingerprinted<byte_order::big>(obj, sink);
+	}
+
+	/**
+	 * Deserialize data with the schema fingerprint from buffer. The fingerprint is checked by one integer comparison before deserialization, so obj is not changed if it does not match.
+	 *
+	 * @param obj A object to deserialize.
+	 * @param buffer A source buffer which has data() and size() member function.
+	 * @param offset A start position of the buffer.
+	 * @tparam Order The byte order of serialized data and the fingerprint.
+	 * @tparam Named Whether to use named_schema_fingerprint_v, which is available only if NAMEOF_MEMBER_SUPPORTED is true.
+	 * @tparam T The type of data to deserialize.
+	 * @throw serialization_error Deserialization is failed or the fingerprint does not match.
+	 */
+	template <byte_order Order, bool Named = false, typename T, typename Buffer>
+	auto deserialize_fingerprinted(T& obj, const Buffer& buffer, const size_t offset = 0) -> decltype(
+		std::declval<Buffer>().data(), std::declval<Buffer>().size(), std::enable_if_t<!std::is_const_v<T>, void>()) {
+		if (offset > buffer.size() || buffer.size() - offset < fingerprinted_serialized_size_v<T, Order>) {
+			throw serialization_error("Deserialization destination is out of range.");
+		}
+
+		const auto data = reinterpret_cast<const uint8_t*>(buffer.data()) + offset;
+		uint64_t fingerprint;
+		deserialize_impl<uint64_t, Order>(fingerprint, data);
+		if (fingerprint != get_schema_fingerprint<T, Named>()) {
+			throw serialization_error("Schema fingerprint of serialized data does not match.");
+		}
+		deserialize_impl<T, Order>(obj, data + schema_fingerprint_size);
+	}
+
+	/**
+	 * Deserialize data with the schema fingerprint from buffer in big endian. The fingerprint is checked by one integer comparison before deserialization, so obj is not changed if it does not match.
+	 *
+	 * @param obj A object to deserialize.
+	 * @param buffer A source buffer which has data() and size() member function.
+	 * @param offset A start position of the buffer.
+	 * @tparam T The type of data to deserialize.
+	 * @throw serialization_error Deserialization is failed or the fingerprint does not match.
+	 */
+	template <typename T, typename Buffer>
+	auto deserialize_fingerprinted(T& obj, const Buffer& buffer, const size_t offset = 0) -> decltype(
+		std::declval<Buffer>().data(), std::declval<Buffer>().size(), std::enable_if_t<!std::is_const_v<T>, void>()) {
+		deserialize_fingerprinted<byte_order::big>(obj, buffer, offset);
+	}
+}
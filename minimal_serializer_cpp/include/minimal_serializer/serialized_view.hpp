@@ -0,0 +1,147 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "serializer.hpp"
+
+namespace minimal_serializer {
+	template <typename T, byte_order Order = byte_order::big>
+	class serialized_view;
+
+	/**
+	 * Read an element from serialized data without checking range. Custom types and std::array are returned as views, and others are deserialized.
+	 */
+	template <typename T, byte_order Order>
+	auto get_serialized_element_impl(const uint8_t* data) {
+		if constexpr (is_serializable_custom_type_v<T> || is_std_array_v<T>) {
+			return serialized_view<T, Order>(data);
+		}
+		else {
+			T value{};
+			deserialize_impl<T, Order>(value, data);
+			return value;
+		}
+	}
+
+	/**
+	 * @brief A read only view of serialized data of T which reads only accessed elements from the data without deserializing whole object.
+	 * Custom type members and std::array members are accessed through nested views. The view does not own the data.
+	 * @tparam T A custom type or std::array.
+	 * @tparam Order The byte order of serialized data.
+	 */
+	template <typename T, byte_order Order>
+	class serialized_view final {
+		static_assert(is_serializable_custom_type_v<T> || is_std_array_v<T>, "T must be a custom type or std::array.");
+
+	public:
+		/**
+		 * @brief Create a view of serialized data. The data must have serialized_size_v<T> bytes.
+		 * @param data A pointer to the top of serialized data of T.
+		 */
+		explicit serialized_view(const uint8_t* data) noexcept : data_(data) {}
+
+		/**
+		 * @brief Get a pointer to the top of serialized data.
+		 * @return The pointer to serialized data.
+		 */
+		[[nodiscard]] const uint8_t* data() const noexcept {
+			return data_;
+		}
+
+		/**
+		 * @brief Get a member of the custom type. Only the bytes of the member are read.
+		 * @tparam MemberPtr A member variable pointer of T which is a serialize target.
+		 * @return A nested view if the member is a custom type or std::array, or the deserialized value of the member otherwise.
+		 */
+		template <auto MemberPtr>
+		[[nodiscard]] auto get() const {
+			static_assert(std::is_same_v<member_variable_pointer_class_t<MemberPtr>, T>, "MemberPtr must be a member of T.");
+			using member_type = remove_cvref_t<member_variable_pointer_variable_t<MemberPtr>>;
+			if constexpr (is_bit_packed_member_v<MemberPtr>) {
+				constexpr auto index = serialize_targets_t<T>::template get_index<MemberPtr>();
+				return from_packed_bits<member_type>(read_packed_bits<bit_packed_layout_v<T>.bit_offsets[index],
+																	serialized_bit_width_v<member_type>>(
+					data_ + serialized_member_offset_v<MemberPtr>));
+			}
+			else {
+				return get_serialized_element_impl<member_type, Order>(data_ + serialized_member_offset_v<MemberPtr>);
+			}
+		}
+
+		/**
+		 * @brief Get the number of elements of std::array.
+		 * @return The number of elements.
+		 */
+		[[nodiscard]] static constexpr size_t size() noexcept {
+			static_assert(is_std_array_v<T>, "size() is available only for std::array.");
+			return std::tuple_size_v<T>;
+		}
+
+		/**
+		 * @brief Get an element of std::array. Only the bytes of the element are read. The index is not checked.
+		 * @param index The index of the element.
+		 * @return A nested view if the element is a custom type or std::array, or the deserialized value of the element otherwise.
+		 */
+		[[nodiscard]] auto operator[](const size_t index) const {
+			static_assert(is_std_array_v<T>, "operator[] is available only for std::array.");
+			using element_type = typename T::value_type;
+			return get_serialized_element_impl<element_type, Order>(data_ + index * serialized_size_v<element_type>);
+		}
+
+		/**
+		 * @brief Deserialize whole object.
+		 * @return The deserialized object.
+		 */
+		[[nodiscard]] T get_object() const {
+			T obj{};
+			deserialize_impl<T, Order>(obj, data_);
+			return obj;
+		}
+
+	private:
+		const uint8_t* data_;
+	};
+
+	/**
+	 * Create a view of serialized data of T in buffer.
+	 *
+	 * @param buffer A source buffer which has data() and size() member function. The buffer must be alive while the view is used.
+	 * @param offset A start position of the source buffer.
+	 * @tparam Order The byte order of serialized data.
+	 * @tparam T A custom type or std::array.
+	 * @return A view of serialized data.
+	 * @throw serialization_error The buffer does not have enough size.
+	 */
+	template <byte_order Order, typename T, typename Buffer>
+	auto make_serialized_view(const Buffer& buffer, size_t offset = 0) -> decltype(
+		std::declval<Buffer>().data(), std::declval<Buffer>().size(), serialized_view<T, Order>(nullptr)) {
+		if (!is_in_serialized_range<T>(buffer.size(), offset)) {
+			throw serialization_error("Deserialization destination is out of range.");
+		}
+
+		return serialized_view<T, Order>(buffer.data() + offset);
+	}
+
+	/**
+	 * Create a view of serialized data of T in big endian in buffer.
+	 *
+	 * @param buffer A source buffer which has data() and size() member function. The buffer must be alive while the view is used.
+	 * @param offset A start position of the source buffer.
+	 * @tparam T A custom type or std::array.
+	 * @return A view of serialized data.
+	 * @throw serialization_error The buffer does not have enough size.
+	 */
+	template <typename T, typename Buffer>
+	auto make_serialized_view(const Buffer& buffer, size_t offset = 0) -> decltype(
+		std::declval<Buffer>().data(), std::declval<Buffer>().size(), serialized_view<T>(nullptr)) {
+		return make_serialized_view<byte_order::big, T>(buffer, offset);
+	}
+}
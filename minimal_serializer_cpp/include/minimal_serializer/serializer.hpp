@@ -10,32 +10,41 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #pragma once
 
+#include <array>
+#include <cstring>
+#include <istream>
+#include <ostream>
+
 #include <boost/endian/conversion.hpp>
 
 #include "type_traits.hpp"
+#include "byte_swap.hpp"
 
 namespace minimal_serializer {
 	class serialization_error final : public std::logic_error {
 		using logic_error::logic_error;
 	};
 
-	template <typename T>
-	void convert_endian_native_to_big_inplace(T& value) {
-		boost::endian::native_to_big_inplace(value);
-	}
-
-	// bool type is endian independent. In addition, bool type is not supported in boost endian conversion from boost library 1.71.0.
-	template <>
-	inline void convert_endian_native_to_big_inplace(bool&) { }
+	/**
+	 * Byte order of serialized data. big is the default and compatible with C# version. native is same as the machine and does not convert anything.
+	 */
+	using byte_order = boost::endian::order;
 
-	template <typename T>
-	void convert_endian_big_to_native_inplace(T& value) {
-		boost::endian::big_to_native_inplace(value);
+	template <byte_order Order, typename T>
+	void convert_endian_native_to_inplace(T& value) {
+		// bool type is endian independent. In addition, bool type is not supported in boost endian conversion from boost library 1.71.0.
+		if constexpr (!std::is_same_v<T, bool>) {
+			boost::endian::conditional_reverse_inplace<byte_order::native, Order>(value);
+		}
 	}
 
-	// bool type is endian independent. In addition, bool type is not supported in boost endian conversion from boost library 1.71.0.
-	template <>
-	inline void convert_endian_big_to_native_inplace(bool&) { }
+	template <byte_order Order, typename T>
+	void convert_endian_to_native_inplace(T& value) {
+		// bool type is endian independent. In addition, bool type is not supported in boost endian conversion from boost library 1.71.0.
+		if constexpr (!std::is_same_v<T, bool>) {
+			boost::endian::conditional_reverse_inplace<Order, byte_order::native>(value);
+		}
+	}
 
 	template <typename T>
 	constexpr auto static_assertion_for_not_serializable_type() -> std::enable_if_t<!is_serializable_v<T>, void> {
@@ -55,6 +64,56 @@ namespace minimal_serializer {
 	template <typename T>
 	constexpr size_t get_serialized_size_impl();
 
+	/**
+	 * The compile time layout of serialized data of a bit packed custom type. Packed targets are in a bit block at the top, and other targets follow it in order.
+	 */
+	template <size_t N>
+	struct bit_packed_layout final {
+		// The bit offsets of packed targets from the lowest bit of the first byte of the bit block.
+		std::array<size_t, N> bit_offsets{};
+		// The byte offsets of targets. Packed targets have the offset of the bit block.
+		std::array<size_t, N> offsets{};
+		size_t block_size = 0;
+		size_t size = 0;
+	};
+
+	template <typename Types, size_t... I>
+	constexpr auto get_bit_packed_layout_impl(std::index_sequence<I...>) {
+		constexpr std::array<size_t, sizeof...(I)> widths{serialized_bit_width_v<std::tuple_element_t<I, Types>>...};
+		constexpr std::array<size_t, sizeof...(I)> sizes{
+			get_serialized_size_impl<remove_cvref_t<std::tuple_element_t<I, Types>>>()...
+		};
+		// A field spans at most 8 bytes so that it is read and written with a 64 bit integer.
+		static_assert(((widths[I] <= 57 && widths[I] <= sizes[I] * 8) && ...),
+					"The bit width must be 57 or less and must not exceed the size of the target.");
+
+		bit_packed_layout<sizeof...(I)> layout;
+		size_t bits = 0;
+		for (size_t i = 0; i < widths.size(); ++i) {
+			if (widths[i] > 0) {
+				layout.bit_offsets[i] = bits;
+				bits += widths[i];
+			}
+		}
+		layout.block_size = (bits + 7) / 8;
+		size_t offset = layout.block_size;
+		for (size_t i = 0; i < widths.size(); ++i) {
+			if (widths[i] == 0) {
+				layout.offsets[i] = offset;
+				offset += sizes[i];
+			}
+		}
+		layout.size = offset;
+		return layout;
+	}
+
+	/**
+	 * The compile time layout of serialized data of a bit packed custom type T.
+	 */
+	template <typename T>
+	constexpr auto bit_packed_layout_v = get_bit_packed_layout_impl<typename serialize_targets_t<T>::types>(
+		std::make_index_sequence<std::tuple_size_v<typename serialize_targets_t<T>::types>>{});
+
 	template <typename T, size_t... I>
 	constexpr size_t get_serialized_size_tuple_impl(std::index_sequence<I...>) {
 		return (get_serialized_size_impl<remove_cvref_t<std::tuple_element_t<I, T>>>() + ...);
@@ -74,12 +133,19 @@ namespace minimal_serializer {
 		else if constexpr (is_serializable_enum_v<raw_t>) {
 			return sizeof(std::underlying_type_t<raw_t>);
 		}
+		else if constexpr (is_std_array_v<raw_t>) {
+			// Calculate by multiplication instead of expanding all elements to keep compile time constant for large arrays.
+			return get_serialized_size_impl<typename raw_t::value_type>() * std::tuple_size_v<raw_t>;
+		}
 		else if constexpr (is_serializable_tuple_v<raw_t>) {
 			return get_serialized_size_tuple<raw_t>();
 		}
 		else if constexpr (is_serializable_boost_static_string_v<raw_t>) {
 			return raw_t::static_capacity;
 		}
+		else if constexpr (is_bit_packed_v<raw_t>) {
+			return bit_packed_layout_v<raw_t>.size;
+		}
 		else if constexpr (is_serializable_custom_type_v<raw_t>) {
 			using target_types = typename serialize_targets_t<raw_t>::types;
 			return get_serialized_size_tuple<target_types>();
@@ -92,91 +158,368 @@ namespace minimal_serializer {
 
 	/**
 	 * The serialized size of T. If T has const, volatile and/or reference, they will be removed.
+	 * The size is same in all byte orders.
 	 */
-	template <typename T>
+	template <typename T, byte_order Order = byte_order::big>
 	constexpr std::size_t serialized_size_v = get_serialized_size_impl<T>();
 
 	/**
 	 * A fixed size byte array of serialized data for T.
 	 */
+	template <typename T, byte_order Order = byte_order::big>
+	using serialized_data = std::array<uint8_t, serialized_size_v<T, Order>>;
+
+	template <typename T, size_t... I>
+	constexpr std::array<size_t, sizeof...(I)> get_serialized_offsets_tuple_impl(std::index_sequence<I...>) {
+		constexpr std::array<size_t, sizeof...(I)> sizes{
+			get_serialized_size_impl<remove_cvref_t<std::tuple_element_t<I, T>>>()...
+		};
+		std::array<size_t, sizeof...(I)> offsets{};
+		size_t offset = 0;
+		for (size_t i = 0; i < sizes.size(); ++i) {
+			offsets[i] = offset;
+			offset += sizes[i];
+		}
+		return offsets;
+	}
+
 	template <typename T>
-	using serialized_data = std::array<uint8_t, serialized_size_v<T>>;
+	constexpr auto get_serialized_offsets_tuple() {
+		return get_serialized_offsets_tuple_impl<T>(std::make_index_sequence<std::tuple_size_v<T>>{});
+	}
 
+	/**
+	 * The serialized offsets of each element in tuple like type T. This is used to place elements in fixed positions in compile time.
+	 */
 	template <typename T>
-	void serialize_impl(const T& obj, uint8_t* buffer_top, const size_t buffer_size, size_t& offset);
+	constexpr auto serialized_tuple_offsets_v = get_serialized_offsets_tuple<remove_cvref_t<T>>();
 
-	template <typename T, size_t I>
-	void serialize_tuple_impl(const T& obj, uint8_t* buffer_top, const size_t buffer_size, size_t& offset) {
-		serialize_impl<remove_cvref_t<std::tuple_element_t<I, T>>>(std::get<I>(obj), buffer_top, buffer_size, offset);
+	template <typename T>
+	constexpr auto get_serialized_offsets_impl() {
+		using raw_t = remove_cvref_t<T>;
+		if constexpr (is_std_array_v<raw_t>) {
+			constexpr auto element_size = get_serialized_size_impl<typename raw_t::value_type>();
+			std::array<size_t, std::tuple_size_v<raw_t>> offsets{};
+			for (size_t i = 0; i < offsets.size(); ++i) {
+				offsets[i] = i * element_size;
+			}
+			return offsets;
+		}
+		else if constexpr (is_serializable_tuple_v<raw_t>) {
+			return serialized_tuple_offsets_v<raw_t>;
+		}
+		else if constexpr (is_bit_packed_v<raw_t>) {
+			return bit_packed_layout_v<raw_t>.offsets;
+		}
+		else if constexpr (is_serializable_custom_type_v<raw_t>) {
+			return serialized_tuple_offsets_v<typename serialize_targets_t<raw_t>::types>;
+		}
+		else {
+			static_assert(is_serializable_tuple_v<raw_t> || is_serializable_custom_type_v<raw_t>,
+						"T must be a tuple like type or a custom type.");
+			return std::array<size_t, 0>{};
+		}
 	}
 
-	template <typename T, size_t... Is>
-	void serialize_tuple_impl(const T& obj, uint8_t* buffer_top, const size_t buffer_size, size_t& offset,
-							std::index_sequence<Is...>) {
-		(serialize_tuple_impl<T, Is>(obj, buffer_top, buffer_size, offset), ...);
+	/**
+	 * The serialized offsets of elements in T from the top of serialized data of T. If T is a custom type, the elements are serialize targets.
+	 * Bit packed targets have the offset of the bit block. If T has const, volatile and/or reference, they will be removed.
+	 */
+	template <typename T>
+	constexpr auto serialized_offsets_v = get_serialized_offsets_impl<T>();
+
+	template <auto MemberPtr>
+	constexpr size_t get_serialized_member_offset_impl() {
+		using class_type = member_variable_pointer_class_t<MemberPtr>;
+		static_assert(is_serializable_custom_type_v<class_type>,
+					"The class of MemberPtr must be a serializable custom type.");
+		using targets = serialize_targets_t<class_type>;
+		constexpr auto index = targets::template get_index<MemberPtr>();
+		static_assert(index < std::tuple_size_v<typename targets::types>, "MemberPtr must be a serialize target.");
+		return serialized_offsets_v<class_type>[index];
+	}
+
+	/**
+	 * The serialized offset of a member indicated by MemberPtr from the top of serialized data of its class. The member must be a serialize target.
+	 */
+	template <auto MemberPtr>
+	constexpr size_t serialized_member_offset_v = get_serialized_member_offset_impl<MemberPtr>();
+
+	/**
+	 * Whether a member indicated by MemberPtr is packed into bits in serialized data of its class.
+	 */
+	template <auto MemberPtr>
+	constexpr bool is_bit_packed_member_v = is_bit_packed_v<member_variable_pointer_class_t<MemberPtr>> &&
+		serialized_bit_width_v<member_variable_pointer_variable_t<MemberPtr>> > 0;
+
+	/**
+	 * Write the lowest Width bits of a value to the bit block at BitOffset without changing other bits.
+	 */
+	template <size_t BitOffset, size_t Width>
+	void write_packed_bits(uint8_t* block, const uint64_t value) noexcept {
+		constexpr size_t first = BitOffset / 8;
+		constexpr size_t shift = BitOffset % 8;
+		constexpr size_t count = (shift + Width + 7) / 8;
+		constexpr uint64_t mask = ((uint64_t{1} << Width) - 1) << shift;
+		const uint64_t bits = value << shift & mask;
+		// The loop count is a constant, so this is unrolled without branches.
+		for (size_t i = 0; i < count; ++i) {
+			const auto byte_mask = static_cast<uint8_t>(mask >> i * 8);
+			block[first + i] = static_cast<uint8_t>((block[first + i] & ~byte_mask) | static_cast<uint8_t>(bits >> i * 8));
+		}
+	}
+
+	/**
+	 * Read Width bits at BitOffset from the bit block.
+	 */
+	template <size_t BitOffset, size_t Width>
+	uint64_t read_packed_bits(const uint8_t* block) noexcept {
+		constexpr size_t first = BitOffset / 8;
+		constexpr size_t shift = BitOffset % 8;
+		constexpr size_t count = (shift + Width + 7) / 8;
+		uint64_t bits = 0;
+		for (size_t i = 0; i < count; ++i) {
+			bits |= static_cast<uint64_t>(block[first + i]) << i * 8;
+		}
+		return bits >> shift & ((uint64_t{1} << Width) - 1);
 	}
 
 	template <typename T>
-	void serialize_tuple(const T& obj, uint8_t* buffer_top, const size_t buffer_size, size_t& offset) {
-		serialize_tuple_impl<T>(obj, buffer_top, buffer_size, offset, std::make_index_sequence<std::tuple_size_v<T>>{});
+	uint64_t to_packed_bits(const T value) noexcept {
+		if constexpr (is_serializable_enum_v<T>) {
+			return static_cast<uint64_t>(static_cast<std::make_unsigned_t<std::underlying_type_t<T>>>(value));
+		}
+		else {
+			return static_cast<uint64_t>(value);
+		}
 	}
 
 	template <typename T>
-	void serialize_impl(const T& obj, uint8_t* buffer_top, const size_t buffer_size, size_t& offset) {
-		if constexpr (is_serializable_builtin_type_v<T>) {
-			constexpr auto size = sizeof(T);
-			if (offset + size > buffer_size) {
-				throw serialization_error("Serialization source is out of range.");
+	T from_packed_bits(const uint64_t bits) noexcept {
+		if constexpr (std::is_same_v<T, bool>) {
+			return bits != 0;
+		}
+		else if constexpr (std::is_signed_v<std::underlying_type_t<T>>) {
+			// Extend the sign bit of the width to the upper bits without branches.
+			constexpr auto sign_bit = uint64_t{1} << (serialized_bit_width_v<T> - 1);
+			return static_cast<T>(static_cast<std::underlying_type_t<T>>((bits ^ sign_bit) - sign_bit));
+		}
+		else {
+			return static_cast<T>(static_cast<std::underlying_type_t<T>>(bits));
+		}
+	}
+
+	template <typename T>
+	void reverse_endian_of_layout_inplace(uint8_t* data);
+
+	/**
+	 * Reverse byte order of all elements in the memory whose layout is same as an array of T. T must satisfy is_serialized_layout_compatible_v.
+	 */
+	template <typename T>
+	void reverse_endian_of_layout_array_inplace(uint8_t* data, const size_t count) {
+		// Arrays of arithmetic types and enums are converted in bulk. This does nothing for byte sized elements such as uint8_t and bool.
+		if constexpr (is_serializable_builtin_type_v<T> || is_serializable_enum_v<T>) {
+			reverse_bytes_array_inplace<sizeof(T)>(data, count);
+		}
+		else {
+			for (size_t i = 0; i < count; ++i) {
+				reverse_endian_of_layout_inplace<T>(data + i * sizeof(T));
+			}
+		}
+	}
+
+	template <typename T, size_t... I>
+	void reverse_endian_of_layout_tuple_inplace(uint8_t* data, std::index_sequence<I...>) {
+		(reverse_endian_of_layout_inplace<std::tuple_element_t<I, T>>(data + serialized_tuple_offsets_v<T>[I]), ...);
+	}
+
+	/**
+	 * Reverse byte order of all elements in the memory whose layout is same as T. T must satisfy is_serialized_layout_compatible_v.
+	 */
+	template <typename T>
+	void reverse_endian_of_layout_inplace(uint8_t* data) {
+		if constexpr (is_serializable_builtin_type_v<T> || is_serializable_enum_v<T>) {
+			reverse_bytes_inplace<sizeof(T)>(data);
+		}
+		else if constexpr (is_std_array_v<T>) {
+			reverse_endian_of_layout_array_inplace<typename T::value_type>(data, std::tuple_size_v<T>);
+		}
+		else {
+			using target_types = typename serialize_targets_t<T>::types;
+			reverse_endian_of_layout_tuple_inplace<target_types>(
+				data, std::make_index_sequence<std::tuple_size_v<target_types>>{});
+		}
+	}
+
+	/**
+	 * Convert endian of serialized data of T whose memory layout is same as T between native and the byte order.
+	 */
+	template <typename T, byte_order Order>
+	void convert_endian_of_layout_inplace(uint8_t* data) {
+		if constexpr (byte_order::native != Order) {
+			reverse_endian_of_layout_inplace<T>(data);
+		}
+	}
+
+	/**
+	 * Convert endian of serialized data of T array whose memory layout is same as the array between native and the byte order.
+	 */
+	template <typename T, byte_order Order>
+	void convert_endian_of_layout_array_inplace(uint8_t* data, const size_t count) {
+		if constexpr (byte_order::native != Order) {
+			reverse_endian_of_layout_array_inplace<T>(data, count);
+		}
+	}
+
+	template <typename T, byte_order Order>
+	void serialize_impl(const T& obj, uint8_t* data);
+
+	template <typename T, byte_order Order, size_t I>
+	void serialize_tuple_impl(const T& obj, uint8_t* data) {
+		serialize_impl<remove_cvref_t<std::tuple_element_t<I, T>>, Order>(std::get<I>(obj),
+																	data + serialized_tuple_offsets_v<T>[I]);
+	}
+
+	template <typename T, byte_order Order, size_t... Is>
+	void serialize_tuple_impl(const T& obj, uint8_t* data, std::index_sequence<Is...>) {
+		(serialize_tuple_impl<T, Order, Is>(obj, data), ...);
+	}
+
+	template <typename T, byte_order Order>
+	void serialize_tuple(const T& obj, uint8_t* data) {
+		serialize_tuple_impl<T, Order>(obj, data, std::make_index_sequence<std::tuple_size_v<T>>{});
+	}
+
+	template <typename T, byte_order Order, size_t BitOffset, size_t Offset>
+	void serialize_bit_packed_element(const T& value, uint8_t* data) {
+		if constexpr (serialized_bit_width_v<T> > 0) {
+			write_packed_bits<BitOffset, serialized_bit_width_v<T>>(data, to_packed_bits(value));
+		}
+		else {
+			serialize_impl<T, Order>(value, data + Offset);
+		}
+	}
+
+	template <typename T, byte_order Order, size_t... Is>
+	void serialize_bit_packed(const T& obj, uint8_t* data, std::index_sequence<Is...>) {
+		using targets = serialize_targets_t<T>;
+		using target_types = typename targets::const_reference_types;
+		constexpr auto& layout = bit_packed_layout_v<T>;
+		const auto target_references = targets::get_const_reference_tuple(obj);
+		// Clear the bit block first so that unused bits are always zero.
+		std::memset(data, 0, layout.block_size);
+		(serialize_bit_packed_element<remove_cvref_t<std::tuple_element_t<Is, target_types>>, Order, layout.bit_offsets[Is],
+									layout.offsets[Is]>(std::get<Is>(target_references), data), ...);
+	}
+
+	/**
+	 * Serialize contiguous objects back to back to the position which is already checked to have enough space for count * serialized_size_v<T> bytes.
+	 */
+	template <typename T, byte_order Order>
+	void serialize_array_impl(const T* objects, const size_t count, uint8_t* data) {
+		if constexpr (is_serialized_layout_compatible_v<T>) {
+			// Copy all objects at once and convert endian of all elements because the memory layout is same as serialized data.
+			std::memcpy(data, objects, sizeof(T) * count);
+			convert_endian_of_layout_array_inplace<T, Order>(data, count);
+		}
+		else {
+			// Serialize elements in a loop instead of expanding all elements to keep template instantiations constant for large arrays.
+			constexpr auto size = serialized_size_v<T>;
+			for (size_t i = 0; i < count; ++i) {
+				serialize_impl<T, Order>(objects[i], data + i * size);
 			}
+		}
+	}
 
-			auto* data_ptr = buffer_top + offset;
-			std::memcpy(data_ptr, &obj, size);
-			auto& e_value = *reinterpret_cast<T*>(data_ptr);
-			convert_endian_native_to_big_inplace(e_value);
-			offset += size;
+	/**
+	 * Serialize data to the position which is already checked to have enough space for serialized_size_v<T> bytes.
+	 */
+	template <typename T, byte_order Order>
+	void serialize_impl(const T& obj, uint8_t* data) {
+		if constexpr (is_serializable_builtin_type_v<T>) {
+			// Convert endian on a local copy and store it at once because data may be not aligned for T.
+			auto e_value = obj;
+			convert_endian_native_to_inplace<Order>(e_value);
+			std::memcpy(data, &e_value, sizeof(T));
 		}
 		else if constexpr (is_serializable_enum_v<T>) {
 			using underlying_type = std::underlying_type_t<T>;
-			serialize_impl<underlying_type>(static_cast<underlying_type>(obj), buffer_top, buffer_size, offset);
+			serialize_impl<underlying_type, Order>(static_cast<underlying_type>(obj), data);
+		}
+		else if constexpr (is_serialized_layout_compatible_v<T>) {
+			// Copy whole object at once and convert endian of all elements because the memory layout is same as serialized data.
+			std::memcpy(data, &obj, sizeof(T));
+			convert_endian_of_layout_inplace<T, Order>(data);
+		}
+		else if constexpr (is_std_array_v<T>) {
+			serialize_array_impl<typename T::value_type, Order>(obj.data(), obj.size(), data);
 		}
 		else if constexpr (is_serializable_tuple_v<T>) {
-			serialize_tuple<T>(obj, buffer_top, buffer_size, offset);
+			serialize_tuple<T, Order>(obj, data);
 		}
 		else if constexpr (is_serializable_boost_static_string_v<T>) {
 			constexpr auto capacity = T::static_capacity;
-			if (offset + capacity > buffer_size) {
-				throw serialization_error("Serialization source is out of range.");
-			}
-
-			auto* data_ptr = buffer_top + offset;
-			obj.copy(reinterpret_cast<typename T::value_type*>(data_ptr), obj.size());
-			for (auto i = obj.size(); i < capacity; ++i) data_ptr[i] = 0;
-			offset += capacity;
+			obj.copy(reinterpret_cast<typename T::value_type*>(data), obj.size());
+			for (auto i = obj.size(); i < capacity; ++i) data[i] = 0;
+		}
+		else if constexpr (is_bit_packed_v<T>) {
+			using target_types = typename serialize_targets_t<T>::types;
+			serialize_bit_packed<T, Order>(obj, data, std::make_index_sequence<std::tuple_size_v<target_types>>{});
 		}
 		else if constexpr (is_serializable_custom_type_v<T>) {
 			using target_types = typename serialize_targets_t<T>::const_reference_types;
 			const auto target_references = serialize_targets_t<T>::get_const_reference_tuple(obj);
-			serialize_tuple<target_types>(target_references, buffer_top, buffer_size, offset);
+			serialize_tuple<target_types, Order>(target_references, data);
 		}
 		else {
 			raise_error_for_not_serializable_type<T>();
 		}
 	}
 
+	/**
+	 * Check whether a buffer has enough space for the serialized data of T from the offset.
+	 */
+	template <typename T>
+	constexpr bool is_in_serialized_range(const size_t buffer_size, const size_t offset) {
+		return offset <= buffer_size && serialized_size_v<T> <= buffer_size - offset;
+	}
+
+	/**
+	 * Check whether a buffer has enough space for the serialized data of count objects of T from the offset.
+	 */
+	template <typename T>
+	constexpr bool is_in_serialized_range(const size_t buffer_size, const size_t offset, const size_t count) {
+		constexpr auto size = serialized_size_v<T>;
+		return offset <= buffer_size && count <= (buffer_size - offset) / size;
+	}
+
 	/**
 	 * Serialize data to size fixed byte array.
 	 * 
 	 * @param obj A object to serialize.
+	 * @tparam Order The byte order of serialized data.
+	 * @tparam T The type of data to serialize.
+	 * @return A serialized byte array.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <byte_order Order, typename T>
+	serialized_data<T, Order> serialize(const T& obj) {
+		serialized_data<T, Order> data;
+		serialize_impl<T, Order>(obj, data.data());
+		return data;
+	}
+
+	/**
+	 * Serialize data to size fixed byte array in big endian.
+	 * 
+	 * @param obj A object to serialize.
 	 * @tparam T The type of data to serialize.
 	 * @return A serialized byte array.
 	 * @throw serialization_error Serialization is failed.
 	 */
 	template <typename T>
 	serialized_data<T> serialize(const T& obj) {
-		size_t offset = 0;
-		serialized_data<T> data;
-		serialize_impl(obj, data.data(), data.size(), offset);
-		return data;
+		return serialize<byte_order::big>(obj);
 	}
 
 	/**
@@ -185,13 +528,34 @@ namespace minimal_serializer {
 	 * @param obj A object to serialize.
 	 * @param buffer A destination buffer which has data() and size() member function.
 	 * @param offset offset A reference start position of source byte array.
+	 * @tparam Order The byte order of serialized data.
+	 * @tparam T The type of data to serialize.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <byte_order Order, typename T, typename Buffer>
+	auto serialize(const T& obj, Buffer& buffer,
+					size_t offset) -> decltype(std::declval<Buffer>().data(), std::declval<Buffer>().size(), void()) {
+		// Check the range only once here because all positions of elements are fixed in compile time.
+		if (!is_in_serialized_range<T>(buffer.size(), offset)) {
+			throw serialization_error("Serialization source is out of range.");
+		}
+
+		serialize_impl<T, Order>(obj, buffer.data() + offset);
+	}
+
+	/**
+	 * Serialize data to buffer in big endian.
+	 * 
+	 * @param obj A object to serialize.
+	 * @param buffer A destination buffer which has data() and size() member function.
+	 * @param offset offset A reference start position of source byte array.
 	 * @tparam T The type of data to serialize.
 	 * @throw serialization_error Serialization is failed.
 	 */
 	template <typename T, typename Buffer>
 	auto serialize(const T& obj, Buffer& buffer,
 					size_t offset) -> decltype(std::declval<Buffer>().data(), std::declval<Buffer>().size(), void()) {
-		serialize_impl(obj, buffer.data(), buffer.size(), offset);
+		serialize<byte_order::big>(obj, buffer, offset);
 	}
 
 	/**
@@ -199,80 +563,227 @@ namespace minimal_serializer {
 	 *
 	 * @param obj A object to serialize to output stream.
 	 * @param stream A destination stream.
+	 * @tparam Order The byte order of serialized data.
 	 * @tparam T The type of data to serialize.
 	 * @throw serialization_error Serialization is failed.
 	 */
-	template <typename T>
+	template <byte_order Order, typename T>
 	void serialize(const T& obj, std::ostream& stream) {
-		const auto buffer = serialize(obj);
-		for (const auto& data : buffer) {
-			stream << data;
+		const auto buffer = serialize<Order>(obj);
+		// Write all bytes at once with unformatted output instead of formatted output for each byte.
+		stream.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+		if (!stream) {
+			throw serialization_error("Failed to write serialized data to the stream.");
 		}
 	}
 
+	/**
+	 * Serialize data to buffer in big endian.
+	 *
+	 * @param obj A object to serialize to output stream.
+	 * @param stream A destination stream.
+	 * @tparam T The type of data to serialize.
+	 * @throw serialization_error Serialization is failed.
+	 */
 	template <typename T>
-	void deserialize_impl(T& obj, const uint8_t* buffer_top, const size_t buffer_size, size_t& offset);
+	void serialize(const T& obj, std::ostream& stream) {
+		serialize<byte_order::big>(obj, stream);
+	}
+
+	/**
+	 * Overwrite only the bytes of a member in serialized data of its class which already exists in buffer.
+	 *
+	 * @param value A new value of the member.
+	 * @param buffer A buffer which has data() and size() member function and has serialized data of the class of the member.
+	 * @param offset A start position of serialized data of the class in the buffer.
+	 * @tparam Order The byte order of serialized data.
+	 * @tparam MemberPtr A member variable pointer which is a serialize target of a custom type.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <byte_order Order, auto MemberPtr, typename Buffer>
+	auto serialize_member(const member_variable_pointer_variable_t<MemberPtr>& value, Buffer& buffer,
+						size_t offset = 0) -> decltype(std::declval<Buffer>().data(), std::declval<Buffer>().size(),
+														void()) {
+		using class_type = member_variable_pointer_class_t<MemberPtr>;
+		using member_type = remove_cvref_t<member_variable_pointer_variable_t<MemberPtr>>;
+		if (!is_in_serialized_range<class_type>(buffer.size(), offset)) {
+			throw serialization_error("Serialization source is out of range.");
+		}
 
-	template <typename T, size_t I>
-	void deserialize_tuple_impl(T& obj, const uint8_t* buffer_top, const size_t buffer_size, size_t& offset) {
-		deserialize_impl<remove_cvref_t<std::tuple_element_t<I, T>>>(std::get<I>(obj), buffer_top, buffer_size, offset);
+		if constexpr (is_bit_packed_member_v<MemberPtr>) {
+			// Overwrite only the bits of the member in the bit block.
+			using targets = serialize_targets_t<class_type>;
+			constexpr auto index = targets::template get_index<MemberPtr>();
+			write_packed_bits<bit_packed_layout_v<class_type>.bit_offsets[index], serialized_bit_width_v<member_type>>(
+				buffer.data() + offset + serialized_member_offset_v<MemberPtr>, to_packed_bits(value));
+		}
+		else {
+			serialize_impl<member_type, Order>(value, buffer.data() + offset + serialized_member_offset_v<MemberPtr>);
+		}
 	}
 
-	template <typename T, size_t... Is>
-	void deserialize_tuple_impl(T& obj, const uint8_t* buffer_top, const size_t buffer_size, size_t& offset,
-								std::index_sequence<Is...>) {
-		(deserialize_tuple_impl<T, Is>(obj, buffer_top, buffer_size, offset), ...);
+	/**
+	 * Overwrite only the bytes of a member in serialized data of its class in big endian which already exists in buffer.
+	 *
+	 * @param value A new value of the member.
+	 * @param buffer A buffer which has data() and size() member function and has serialized data of the class of the member.
+	 * @param offset A start position of serialized data of the class in the buffer.
+	 * @tparam MemberPtr A member variable pointer which is a serialize target of a custom type.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <auto MemberPtr, typename Buffer>
+	auto serialize_member(const member_variable_pointer_variable_t<MemberPtr>& value, Buffer& buffer,
+						size_t offset = 0) -> decltype(std::declval<Buffer>().data(), std::declval<Buffer>().size(),
+														void()) {
+		serialize_member<byte_order::big, MemberPtr>(value, buffer, offset);
 	}
 
-	template <typename T>
-	void deserialize_tuple(T& obj, const uint8_t* buffer_top, const size_t buffer_size, size_t& offset) {
-		deserialize_tuple_impl<T>(obj, buffer_top, buffer_size, offset,
-								std::make_index_sequence<std::tuple_size_v<T>>{});
+	/**
+	 * Serialize contiguous objects to buffer back to back. The i-th object is written at offset + i * serialized_size_v<T>.
+	 *
+	 * @param objects A source range which has data() and size() member function such as std::vector<T> and std::span<const T>.
+	 * @param buffer A destination buffer which has data() and size() member function.
+	 * @param offset A start position of the destination buffer.
+	 * @tparam Order The byte order of serialized data.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <byte_order Order, typename Range, typename Buffer>
+	auto serialize_range(Range&& objects, Buffer& buffer,
+						size_t offset = 0) -> decltype(objects.data(), objects.size(), std::declval<Buffer>().data(),
+														std::declval<Buffer>().size(), void()) {
+		using object_type = remove_cvref_t<decltype(*objects.data())>;
+		const auto count = static_cast<size_t>(objects.size());
+		// Check the range only once here because positions of all objects are fixed.
+		if (!is_in_serialized_range<object_type>(buffer.size(), offset, count)) {
+			throw serialization_error("Serialization source is out of range.");
+		}
+		if (count == 0) {
+			return;
+		}
+
+		serialize_array_impl<object_type, Order>(objects.data(), count, buffer.data() + offset);
 	}
 
-	template <class T>
-	void deserialize_impl(T& obj, const uint8_t* buffer_top, const size_t buffer_size, size_t& offset) {
-		if constexpr (is_serializable_builtin_type_v<T>) {
-			const auto size = sizeof(T);
-			if (offset + size > buffer_size) {
-				throw serialization_error("Deserialization destination is out of range.");
+	/**
+	 * Serialize contiguous objects to buffer back to back in big endian. The i-th object is written at offset + i * serialized_size_v<T>.
+	 *
+	 * @param objects A source range which has data() and size() member function such as std::vector<T> and std::span<const T>.
+	 * @param buffer A destination buffer which has data() and size() member function.
+	 * @param offset A start position of the destination buffer.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <typename Range, typename Buffer>
+	auto serialize_range(Range&& objects, Buffer& buffer,
+						size_t offset = 0) -> decltype(objects.data(), objects.size(), std::declval<Buffer>().data(),
+														std::declval<Buffer>().size(), void()) {
+		serialize_range<byte_order::big>(std::forward<Range>(objects), buffer, offset);
+	}
+
+	template <typename T, byte_order Order>
+	void deserialize_impl(T& obj, const uint8_t* data);
+
+	template <typename T, byte_order Order, size_t I>
+	void deserialize_tuple_impl(T& obj, const uint8_t* data) {
+		deserialize_impl<remove_cvref_t<std::tuple_element_t<I, T>>, Order>(std::get<I>(obj),
+																	data + serialized_tuple_offsets_v<T>[I]);
+	}
+
+	template <typename T, byte_order Order, size_t... Is>
+	void deserialize_tuple_impl(T& obj, const uint8_t* data, std::index_sequence<Is...>) {
+		(deserialize_tuple_impl<T, Order, Is>(obj, data), ...);
+	}
+
+	template <typename T, byte_order Order>
+	void deserialize_tuple(T& obj, const uint8_t* data) {
+		deserialize_tuple_impl<T, Order>(obj, data, std::make_index_sequence<std::tuple_size_v<T>>{});
+	}
+
+	template <typename T, byte_order Order, size_t BitOffset, size_t Offset>
+	void deserialize_bit_packed_element(T& value, const uint8_t* data) {
+		if constexpr (serialized_bit_width_v<T> > 0) {
+			value = from_packed_bits<T>(read_packed_bits<BitOffset, serialized_bit_width_v<T>>(data));
+		}
+		else {
+			deserialize_impl<T, Order>(value, data + Offset);
+		}
+	}
+
+	template <typename T, byte_order Order, size_t... Is>
+	void deserialize_bit_packed(T& obj, const uint8_t* data, std::index_sequence<Is...>) {
+		using targets = serialize_targets_t<T>;
+		using target_types = typename targets::reference_types;
+		constexpr auto& layout = bit_packed_layout_v<T>;
+		auto target_references = targets::get_reference_tuple(obj);
+		(deserialize_bit_packed_element<remove_cvref_t<std::tuple_element_t<Is, target_types>>, Order,
+										layout.bit_offsets[Is], layout.offsets[Is]>(std::get<Is>(target_references), data), ...);
+	}
+
+	/**
+	 * Deserialize contiguous objects from the position which is already checked to have count * serialized_size_v<T> bytes.
+	 */
+	template <typename T, byte_order Order>
+	void deserialize_array_impl(T* objects, const size_t count, const uint8_t* data) {
+		if constexpr (is_serialized_layout_compatible_v<T>) {
+			// Copy all objects at once and convert endian of all elements because the memory layout is same as serialized data.
+			std::memcpy(objects, data, sizeof(T) * count);
+			convert_endian_of_layout_array_inplace<T, Order>(reinterpret_cast<uint8_t*>(objects), count);
+		}
+		else {
+			// Deserialize elements in a loop instead of expanding all elements to keep template instantiations constant for large arrays.
+			constexpr auto size = serialized_size_v<T>;
+			for (size_t i = 0; i < count; ++i) {
+				deserialize_impl<T, Order>(objects[i], data + i * size);
 			}
+		}
+	}
 
-			std::memcpy(&obj, buffer_top + offset, size);
-			convert_endian_big_to_native_inplace(obj);
-			offset += size;
+	/**
+	 * Deserialize data from the position which is already checked to have serialized_size_v<T> bytes.
+	 */
+	template <typename T, byte_order Order>
+	void deserialize_impl(T& obj, const uint8_t* data) {
+		if constexpr (is_serializable_builtin_type_v<T>) {
+			std::memcpy(&obj, data, sizeof(T));
+			convert_endian_to_native_inplace<Order>(obj);
 		}
 		else if constexpr (is_serializable_enum_v<T>) {
 			using underlying_type = std::underlying_type_t<T>;
 			// In order to cast with referencing same value, cast via pointer.
-			deserialize_impl<underlying_type>(*reinterpret_cast<underlying_type*>(&obj), buffer_top, buffer_size,
-											offset);
+			deserialize_impl<underlying_type, Order>(*reinterpret_cast<underlying_type*>(&obj), data);
+		}
+		else if constexpr (is_serialized_layout_compatible_v<T>) {
+			// Copy whole object at once and convert endian of all elements because the memory layout is same as serialized data.
+			std::memcpy(&obj, data, sizeof(T));
+			convert_endian_of_layout_inplace<T, Order>(reinterpret_cast<uint8_t*>(&obj));
+		}
+		else if constexpr (is_std_array_v<T>) {
+			deserialize_array_impl<typename T::value_type, Order>(obj.data(), obj.size(), data);
 		}
 		else if constexpr (is_serializable_tuple_v<T>) {
-			deserialize_tuple<T>(obj, buffer_top, buffer_size, offset);
+			deserialize_tuple<T, Order>(obj, data);
 		}
 		else if constexpr (is_serializable_boost_static_string_v<T>) {
 			constexpr auto capacity = T::static_capacity;
-			if (offset + capacity > buffer_size) {
-				throw serialization_error("Deserialization destination is out of range.");
-			}
 
 			// Calculate the length of string.
 			using char_type = typename T::value_type;
-			const auto* char_offset_buffer = reinterpret_cast<const char_type*>(buffer_top + offset);
+			const auto* char_offset_buffer = reinterpret_cast<const char_type*>(data);
 			const auto eof = T::traits_type::find(char_offset_buffer, capacity, char_type());
 			const auto size = eof != nullptr ? eof - char_offset_buffer : capacity;
 			// Copy string with specifying actual length.
 			// Note: std::memcpy() is not used because it does not set the size in boost::static_string.
 			// Note: Specify actual string size instead of capacity because assign set the third parameter as the size of string even if there is null character in the middle of string.
 			// Note: Specify actual string size instead of use overload of assign() without size because it throws exception when the length of the string equals to capacity.
-			obj.assign(reinterpret_cast<const typename T::value_type*>(buffer_top + offset), size);
-			offset += capacity;
+			obj.assign(char_offset_buffer, size);
+		}
+		else if constexpr (is_bit_packed_v<T>) {
+			using target_types = typename serialize_targets_t<T>::types;
+			deserialize_bit_packed<T, Order>(obj, data, std::make_index_sequence<std::tuple_size_v<target_types>>{});
 		}
 		else if constexpr (is_serializable_custom_type_v<T>) {
 			using target_types = typename serialize_targets_t<T>::reference_types;
 			auto target_references = serialize_targets_t<T>::get_reference_tuple(obj);
-			deserialize_tuple<target_types>(target_references, buffer_top, buffer_size, offset);
+			deserialize_tuple<target_types, Order>(target_references, data);
 		}
 		else {
 			raise_error_for_not_serializable_type<T>();
@@ -285,6 +796,28 @@ namespace minimal_serializer {
 	 * @param obj A object to deserialize.
 	 * @param buffer A source buffer which has data() and size() member function.
 	 * @param offset A reference start position of source byte array.
+	 * @tparam Order The byte order of serialized data.
+	 * @tparam T The type of data to deserialize.
+	 * @throw serialization_error Deserialization is failed.
+	 */
+	template <byte_order Order, typename T, typename Buffer>
+	auto deserialize(T& obj, const Buffer& buffer,
+					size_t offset = 0) -> decltype(std::declval<Buffer>().data(), std::declval<Buffer>().size(),
+		std::enable_if_t<!std::is_const_v<T>, void>()) {
+		// Check the range only once here because all positions of elements are fixed in compile time.
+		if (!is_in_serialized_range<T>(buffer.size(), offset)) {
+			throw serialization_error("Deserialization destination is out of range.");
+		}
+
+		deserialize_impl<T, Order>(obj, buffer.data() + offset);
+	}
+
+	/**
+	 * Deserialize data from buffer in big endian.
+	 * 
+	 * @param obj A object to deserialize.
+	 * @param buffer A source buffer which has data() and size() member function.
+	 * @param offset A reference start position of source byte array.
 	 * @tparam T The type of data to deserialize.
 	 * @throw serialization_error Deserialization is failed.
 	 */
@@ -292,7 +825,7 @@ namespace minimal_serializer {
 	auto deserialize(T& obj, const Buffer& buffer,
 					size_t offset = 0) -> decltype(std::declval<Buffer>().data(), std::declval<Buffer>().size(),
 		std::enable_if_t<!std::is_const_v<T>, void>()) {
-		deserialize_impl(obj, buffer.data(), buffer.size(), offset);
+		deserialize<byte_order::big>(obj, buffer, offset);
 	}
 
 	/**
@@ -300,15 +833,76 @@ namespace minimal_serializer {
 	 *
 	 * @param obj A object to deserialize.
 	 * @param stream A source input stream.
+	 * @tparam Order The byte order of serialized data.
+	 * @tparam T The type of data to deserialize.
+	 * @throw serialization_error Deserialization is failed.
+	 */
+	template <byte_order Order, typename T>
+	auto deserialize(T& obj, std::istream& stream) -> std::enable_if_t<!std::is_const_v<T>, void> {
+		serialized_data<T, Order> buffer;
+		// Read all bytes at once with unformatted input because formatted input skips bytes regarded as whitespace.
+		stream.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+		if (static_cast<size_t>(stream.gcount()) != buffer.size()) {
+			throw serialization_error("Failed to read serialized data from the stream.");
+		}
+		deserialize<Order>(obj, buffer);
+	}
+
+	/**
+	 * Deserialize data from input stream in big endian.
+	 *
+	 * @param obj A object to deserialize.
+	 * @param stream A source input stream.
 	 * @tparam T The type of data to deserialize.
 	 * @throw serialization_error Deserialization is failed.
 	 */
 	template <typename T>
 	auto deserialize(T& obj, std::istream& stream) -> std::enable_if_t<!std::is_const_v<T>, void> {
-		serialized_data<T> buffer;
-		for (auto&& data : buffer) {
-			stream >> data;
+		deserialize<byte_order::big>(obj, stream);
+	}
+
+	/**
+	 * Deserialize contiguous objects from buffer in which objects are serialized back to back. The i-th object is read from offset + i * serialized_size_v<T>.
+	 *
+	 * @param objects A destination range which has data() and size() member function such as std::vector<T> and std::span<T>.
+	 * @param buffer A source buffer which has data() and size() member function.
+	 * @param offset A start position of the source buffer.
+	 * @tparam Order The byte order of serialized data.
+	 * @throw serialization_error Deserialization is failed.
+	 */
+	template <byte_order Order, typename Range, typename Buffer>
+	auto deserialize_range(Range&& objects, const Buffer& buffer,
+							size_t offset = 0) -> decltype(objects.data(), objects.size(), std::declval<Buffer>().data(),
+															std::declval<Buffer>().size(),
+															std::enable_if_t<!std::is_const_v<std::remove_reference_t<
+																decltype(*objects.data())>>, void>()) {
+		using object_type = remove_cvref_t<decltype(*objects.data())>;
+		const auto count = static_cast<size_t>(objects.size());
+		// Check the range only once here because positions of all objects are fixed.
+		if (!is_in_serialized_range<object_type>(buffer.size(), offset, count)) {
+			throw serialization_error("Deserialization destination is out of range.");
+		}
+		if (count == 0) {
+			return;
 		}
-		deserialize(obj, buffer);
+
+		deserialize_array_impl<object_type, Order>(objects.data(), count, buffer.data() + offset);
+	}
+
+	/**
+	 * Deserialize contiguous objects from buffer in which objects are serialized back to back in big endian. The i-th object is read from offset + i * serialized_size_v<T>.
+	 *
+	 * @param objects A destination range which has data() and size() member function such as std::vector<T> and std::span<T>.
+	 * @param buffer A source buffer which has data() and size() member function.
+	 * @param offset A start position of the source buffer.
+	 * @throw serialization_error Deserialization is failed.
+	 */
+	template <typename Range, typename Buffer>
+	auto deserialize_range(Range&& objects, const Buffer& buffer,
+							size_t offset = 0) -> decltype(objects.data(), objects.size(), std::declval<Buffer>().data(),
+															std::declval<Buffer>().size(),
+															std::enable_if_t<!std::is_const_v<std::remove_reference_t<
+																decltype(*objects.data())>>, void>()) {
+		deserialize_range<byte_order::big>(std::forward<Range>(objects), buffer, offset);
 	}
 }
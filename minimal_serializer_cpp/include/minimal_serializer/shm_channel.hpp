@@ -0,0 +1,339 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "posix_io.hpp"
+
+// Shared memory channel uses futex which is available only in Linux.
+#if defined(MINIMAL_SERIALIZER_POSIX_IO) && defined(__linux__)
+#define MINIMAL_SERIALIZER_SHM_CHANNEL
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <new>
+#include <string>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#include "memory_utility.hpp"
+#include "serializer.hpp"
+
+namespace minimal_serializer {
+	/**
+	 * How a shm_channel opens shared memory.
+	 */
+	enum class shm_channel_mode {
+		// Create new shared memory. It fails if the shared memory already exists. The shared memory is removed when the channel is destroyed.
+		create,
+		// Open shared memory created by other channel.
+		open,
+	};
+
+	/**
+	 * Options of shm_channel.
+	 */
+	struct shm_channel_options final {
+		// The number of slots which is used only in create mode. This is rounded up to a power of two.
+		size_t capacity = 1024;
+		// The number of retries before sleeping in blocking operations. 0 means sleeping immediately.
+		uint32_t spin_count = 1000;
+	};
+
+	/**
+	 * @brief A channel of fixed size serialized records between one producer and one consumer in different processes on the same host.
+	 * Records are stored in a ring buffer in POSIX shared memory, and blocking operations sleep with futex after spinning.
+	 * @tparam T The type of records.
+	 * @tparam Order The byte order of serialized data.
+	 */
+	template <typename T, byte_order Order = byte_order::big>
+	class shm_channel final {
+	public:
+		/**
+		 * The serialized size of a record, which is the size of a slot.
+		 */
+		static constexpr size_t record_size = serialized_size_v<T, Order>;
+
+		/**
+		 * @brief Create or open a channel.
+		 * @param name The name of shared memory which starts with '/'.
+		 * @param mode Whether to create or open the shared memory.
+		 * @param options Options of the channel.
+		 * @throw std::system_error Creating, opening or mapping the shared memory is failed.
+		 * @throw serialization_error The shared memory is not initialized or is for a different record size.
+		 */
+		shm_channel(const char* name, const shm_channel_mode mode, const shm_channel_options& options = {})
+			: name_(name), mode_(mode), spin_count_(options.spin_count) {
+			const auto flags = mode == shm_channel_mode::create ? O_CREAT | O_EXCL | O_RDWR : O_RDWR;
+			const auto fd = ::shm_open(name, flags, 0600);
+			if (fd < 0) {
+				throw_last_system_error("Failed to open the shared memory.");
+			}
+
+			try {
+				if (mode == shm_channel_mode::create) {
+					create(fd, options.capacity);
+				}
+				else {
+					open(fd);
+				}
+			}
+			catch (...) {
+				::close(fd);
+				if (mapping_ != nullptr) {
+					::munmap(mapping_, mapping_size_);
+				}
+				if (mode == shm_channel_mode::create) {
+					::shm_unlink(name);
+				}
+				throw;
+			}
+			::close(fd);
+		}
+
+		shm_channel(const shm_channel&) = delete;
+		shm_channel(shm_channel&&) = delete;
+
+		/**
+		 * @brief Unmap the shared memory, and remove it if this channel created it.
+		 */
+		~shm_channel() {
+			::munmap(mapping_, mapping_size_);
+			if (mode_ == shm_channel_mode::create) {
+				::shm_unlink(name_.c_str());
+			}
+		}
+
+		shm_channel& operator=(const shm_channel&) = delete;
+		shm_channel& operator=(shm_channel&&) = delete;
+
+		/**
+		 * @brief Get the number of slots.
+		 * @return The number of slots.
+		 */
+		[[nodiscard]] size_t capacity() const noexcept {
+			return header_->capacity;
+		}
+
+		/**
+		 * @brief Claim a free slot to write a serialized record. This must be called only from the producer.
+		 * @return The pointer to the slot, or nullptr if the channel is full.
+		 */
+		[[nodiscard]] uint8_t* try_claim() noexcept {
+			const auto tail = header_->tail.load(std::memory_order_relaxed);
+			if (tail - header_->head.load(std::memory_order_acquire) == header_->capacity) {
+				return nullptr;
+			}
+			return slot(tail);
+		}
+
+		/**
+		 * @brief Make the claimed slot visible to the consumer and wake it up if it is sleeping. This must be called only from the producer after try_claim() succeeds.
+		 */
+		void publish() noexcept {
+			header_->tail.store(header_->tail.load(std::memory_order_relaxed) + 1, std::memory_order_seq_cst);
+			if (header_->consumer_waiting.load(std::memory_order_seq_cst) != 0) {
+				wake(header_->tail);
+			}
+		}
+
+		/**
+		 * @brief Serialize a record into a free slot and publish it. This must be called only from the producer.
+		 * @param obj A record to push.
+		 * @return Whether the record is pushed. This is false if the channel is full.
+		 */
+		bool try_push(const T& obj) {
+			auto* data = try_claim();
+			if (data == nullptr) {
+				return false;
+			}
+			serialize_impl<T, Order>(obj, data);
+			publish();
+			return true;
+		}
+
+		/**
+		 * @brief Serialize a record into a free slot and publish it. If the channel is full, this spins and then sleeps until the consumer frees a slot. This must be called only from the producer.
+		 * @param obj A record to push.
+		 */
+		void push(const T& obj) {
+			auto* data = try_claim();
+			for (uint32_t i = 0; data == nullptr && i < spin_count_; ++i) {
+				data = try_claim();
+			}
+			while (data == nullptr) {
+				// Check the index again after setting the flag so that the consumer never misses to wake this up.
+				const auto head = header_->head.load(std::memory_order_relaxed);
+				header_->producer_waiting.store(1, std::memory_order_seq_cst);
+				if (header_->tail.load(std::memory_order_relaxed) - header_->head.load(std::memory_order_seq_cst) ==
+					header_->capacity) {
+					wait(header_->head, head);
+				}
+				header_->producer_waiting.store(0, std::memory_order_relaxed);
+				data = try_claim();
+			}
+			serialize_impl<T, Order>(obj, data);
+			publish();
+		}
+
+		/**
+		 * @brief Get the oldest published slot without removing it. This must be called only from the consumer.
+		 * @return The pointer to serialized data in the slot, or nullptr if the channel is empty. The data is valid until release() is called.
+		 */
+		[[nodiscard]] const uint8_t* try_peek() noexcept {
+			const auto head = header_->head.load(std::memory_order_relaxed);
+			if (head == header_->tail.load(std::memory_order_acquire)) {
+				return nullptr;
+			}
+			return slot(head);
+		}
+
+		/**
+		 * @brief Return the peeked slot to the producer and wake it up if it is sleeping. This must be called only from the consumer after try_peek() succeeds.
+		 */
+		void release() noexcept {
+			header_->head.store(header_->head.load(std::memory_order_relaxed) + 1, std::memory_order_seq_cst);
+			if (header_->producer_waiting.load(std::memory_order_seq_cst) != 0) {
+				wake(header_->head);
+			}
+		}
+
+		/**
+		 * @brief Deserialize the oldest record and remove it. This must be called only from the consumer.
+		 * @param obj A destination object.
+		 * @return Whether a record is popped. This is false if the channel is empty.
+		 */
+		bool try_pop(T& obj) {
+			const auto* data = try_peek();
+			if (data == nullptr) {
+				return false;
+			}
+			deserialize_impl<T, Order>(obj, data);
+			release();
+			return true;
+		}
+
+		/**
+		 * @brief Deserialize the oldest record and remove it. If the channel is empty, this spins and then sleeps until the producer publishes a record. This must be called only from the consumer.
+		 * @param obj A destination object.
+		 */
+		void pop(T& obj) {
+			auto* data = try_peek();
+			for (uint32_t i = 0; data == nullptr && i < spin_count_; ++i) {
+				data = try_peek();
+			}
+			while (data == nullptr) {
+				// Check the index again after setting the flag so that the producer never misses to wake this up.
+				const auto tail = header_->tail.load(std::memory_order_relaxed);
+				header_->consumer_waiting.store(1, std::memory_order_seq_cst);
+				if (header_->tail.load(std::memory_order_seq_cst) == header_->head.load(std::memory_order_relaxed)) {
+					wait(header_->tail, tail);
+				}
+				header_->consumer_waiting.store(0, std::memory_order_relaxed);
+				data = try_peek();
+			}
+			deserialize_impl<T, Order>(obj, data);
+			release();
+		}
+
+	private:
+		static constexpr uint64_t magic_number = 0x6d696e5f73686d31; // "min_shm1"
+
+		// The header placed at the top of the shared memory. Indices are 32 bit to be used as futex words, and they wrap around because the capacity is a power of two.
+		struct header final {
+			std::atomic<uint64_t> magic;
+			uint32_t record_size;
+			uint32_t capacity;
+			alignas(cache_line_size) std::atomic<uint32_t> tail;
+			std::atomic<uint32_t> consumer_waiting;
+			alignas(cache_line_size) std::atomic<uint32_t> head;
+			std::atomic<uint32_t> producer_waiting;
+		};
+
+		static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+					"Atomic variables in shared memory must be lock free.");
+
+		static constexpr size_t slots_offset = (sizeof(header) + cache_line_size - 1) / cache_line_size * cache_line_size;
+
+		std::string name_;
+		shm_channel_mode mode_;
+		uint32_t spin_count_;
+		void* mapping_ = nullptr;
+		size_t mapping_size_ = 0;
+		header* header_ = nullptr;
+		uint8_t* slots_ = nullptr;
+
+		void map(const int fd, const size_t size) {
+			auto* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			if (mapping == MAP_FAILED) {
+				throw_last_system_error("Failed to map the shared memory.");
+			}
+			mapping_ = mapping;
+			mapping_size_ = size;
+			header_ = static_cast<header*>(mapping);
+			slots_ = static_cast<uint8_t*>(mapping) + slots_offset;
+		}
+
+		void create(const int fd, const size_t capacity) {
+			const auto rounded_capacity = round_up_to_power_of_two(capacity);
+			if (rounded_capacity > (size_t{1} << 31)) {
+				throw serialization_error("The capacity of the channel must be less than or equal to 2^31.");
+			}
+			const auto size = slots_offset + rounded_capacity * record_size;
+			if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+				throw_last_system_error("Failed to resize the shared memory.");
+			}
+			map(fd, size);
+
+			auto* h = new(mapping_) header{};
+			h->record_size = static_cast<uint32_t>(record_size);
+			h->capacity = static_cast<uint32_t>(rounded_capacity);
+			// Publish the magic number last so that other processes see the initialized header.
+			h->magic.store(magic_number, std::memory_order_release);
+		}
+
+		void open(const int fd) {
+			struct stat st{};
+			if (::fstat(fd, &st) != 0) {
+				throw_last_system_error("Failed to get the size of the shared memory.");
+			}
+			const auto size = static_cast<size_t>(st.st_size);
+			if (size < slots_offset) {
+				throw serialization_error("The shared memory is not initialized.");
+			}
+			map(fd, size);
+			if (header_->magic.load(std::memory_order_acquire) != magic_number) {
+				throw serialization_error("The shared memory is not initialized.");
+			}
+			if (header_->record_size != record_size || slots_offset + size_t{header_->capacity} * record_size > size) {
+				throw serialization_error("The shared memory is for a different type of records.");
+			}
+		}
+
+		[[nodiscard]] uint8_t* slot(const uint32_t index) const noexcept {
+			return slots_ + static_cast<size_t>(index & (header_->capacity - 1)) * record_size;
+		}
+
+		// Sleep while the value is expected. Futex operations are not private because the memory is shared between processes.
+		static void wait(std::atomic<uint32_t>& value, const uint32_t expected) noexcept {
+			::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&value), FUTEX_WAIT, expected, nullptr, nullptr, 0);
+		}
+
+		static void wake(std::atomic<uint32_t>& value) noexcept {
+			::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&value), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+		}
+	};
+}
+#endif
@@ -0,0 +1,342 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "memory_utility.hpp"
+#include "serializer.hpp"
+
+namespace minimal_serializer {
+	/**
+	 * @brief A sink which appends serialized data to the end of a resizable contiguous container such as std::vector<uint8_t>.
+	 * Use a container with default_init_allocator such as std::vector<uint8_t, default_init_allocator<uint8_t>> to avoid filling reserved bytes with zero before they are overwritten.
+	 * @tparam Container The type of the container which has data(), size() and resize() member functions.
+	 */
+	template <typename Container>
+	class container_sink final {
+	public:
+		/**
+		 * @brief Create a sink which appends to a container.
+		 * @param container A destination container. It must be alive while the sink is used.
+		 */
+		explicit container_sink(Container& container) noexcept : container_(container),
+																	committed_size_(container.size()) {}
+
+		/**
+		 * @brief Extend the container and get the memory to write to.
+		 * @param size The number of bytes to write.
+		 * @return The pointer to the reserved bytes.
+		 */
+		uint8_t* reserve(const size_t size) {
+			committed_size_ = container_.size();
+			container_.resize(committed_size_ + size);
+			return reinterpret_cast<uint8_t*>(container_.data()) + committed_size_;
+		}
+
+		/**
+		 * @brief Keep the first bytes of the reserved bytes and drop the rest.
+		 * @param size The number of bytes written to the reserved bytes.
+		 */
+		void commit(const size_t size) {
+			committed_size_ += size;
+			container_.resize(committed_size_);
+		}
+
+	private:
+		Container& container_;
+		size_t committed_size_;
+	};
+
+	/**
+	 * @brief A sink which writes serialized data to a fixed size buffer from the front.
+	 * @tparam Buffer The type of the buffer which has data() and size() member functions.
+	 */
+	template <typename Buffer>
+	class buffer_sink final {
+	public:
+		/**
+		 * @brief Create a sink which writes to a buffer.
+		 * @param buffer A destination buffer. It must be alive while the sink is used.
+		 * @param offset A start position of the buffer.
+		 */
+		explicit buffer_sink(Buffer& buffer, const size_t offset = 0) noexcept : buffer_(buffer), position_(offset) {}
+
+		/**
+		 * @brief Get the memory to write to.
+		 * @param size The number of bytes to write.
+		 * @return The pointer to the reserved bytes, or nullptr if the rest of the buffer is too small.
+		 */
+		uint8_t* reserve(const size_t size) noexcept {
+			if (position_ > buffer_.size() || buffer_.size() - position_ < size) {
+				return nullptr;
+			}
+			return reinterpret_cast<uint8_t*>(buffer_.data()) + position_;
+		}
+
+		/**
+		 * @brief Advance the position after writing to the reserved bytes.
+		 * @param size The number of bytes written.
+		 */
+		void commit(const size_t size) noexcept {
+			position_ += size;
+		}
+
+		/**
+		 * @brief Get the position where the next bytes are written.
+		 * @return The position in the buffer.
+		 */
+		[[nodiscard]] size_t position() const noexcept {
+			return position_;
+		}
+
+	private:
+		Buffer& buffer_;
+		size_t position_;
+	};
+
+	/**
+	 * @brief A source which reads serialized data from a buffer from the front.
+	 * @tparam Buffer The type of the buffer which has data() and size() member functions.
+	 */
+	template <typename Buffer>
+	class buffer_source final {
+	public:
+		/**
+		 * @brief Create a source which reads from a buffer.
+		 * @param buffer A source buffer. It must be alive while the source is used.
+		 * @param offset A start position of the buffer.
+		 */
+		explicit buffer_source(const Buffer& buffer, const size_t offset = 0) noexcept : buffer_(buffer),
+			position_(offset) {}
+
+		/**
+		 * @brief Get the memory to read from without advancing the position.
+		 * @param size The number of bytes to read.
+		 * @return The pointer to the bytes, or nullptr if the rest of the buffer is too small.
+		 */
+		const uint8_t* peek(const size_t size) const noexcept {
+			if (position_ > buffer_.size() || buffer_.size() - position_ < size) {
+				return nullptr;
+			}
+			return reinterpret_cast<const uint8_t*>(buffer_.data()) + position_;
+		}
+
+		/**
+		 * @brief Advance the position after reading bytes.
+		 * @param size The number of bytes read.
+		 */
+		void consume(const size_t size) noexcept {
+			position_ += size;
+		}
+
+		/**
+		 * @brief Get the position where the next bytes are read.
+		 * @return The position in the buffer.
+		 */
+		[[nodiscard]] size_t position() const noexcept {
+			return position_;
+		}
+
+	private:
+		const Buffer& buffer_;
+		size_t position_;
+	};
+
+	template <typename Sink, typename = void>
+	struct is_serialization_sink : std::false_type {};
+
+	template <typename Sink>
+	struct is_serialization_sink<Sink, std::enable_if_t<
+									std::is_same_v<decltype(std::declval<Sink&>().reserve(size_t{})), uint8_t*>,
+									decltype(std::declval<Sink&>().commit(size_t{}), void())>> : std::true_type {};
+
+	/**
+	 * @brief Whether the type is a sink which has "uint8_t* reserve(size_t)" to get writable memory and "void commit(size_t)" to complete writing.
+	 * reserve() returns nullptr if the requested bytes are not available.
+	 */
+	template <typename Sink>
+	constexpr bool is_serialization_sink_v = is_serialization_sink<Sink>::value;
+
+	template <typename Source, typename = void>
+	struct is_deserialization_source : std::false_type {};
+
+	template <typename Source>
+	struct is_deserialization_source<Source, std::enable_if_t<
+										std::is_same_v<decltype(std::declval<Source&>().peek(size_t{})), const uint8_t*>,
+										decltype(std::declval<Source&>().consume(size_t{}), void())>> : std::true_type {};
+
+	/**
+	 * @brief Whether the type is a source which has "const uint8_t* peek(size_t)" to get readable memory and "void consume(size_t)" to complete reading.
+	 * peek() returns nullptr if the requested bytes are not available.
+	 */
+	template <typename Source>
+	constexpr bool is_deserialization_source_v = is_deserialization_source<Source>::value;
+
+	/**
+	 * Serialize data to sink.
+	 *
+	 * @param obj A object to serialize.
+	 * @param sink A destination sink which satisfies is_serialization_sink_v.
+	 * @tparam Order The byte order of serialized data.
+	 * @tparam T The type of data to serialize.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <byte_order Order, typename T, typename Sink>
+	auto serialize(const T& obj, Sink& sink) -> std::enable_if_t<is_serialization_sink_v<Sink>, void> {
+		constexpr auto size = serialized_size_v<T, Order>;
+		const auto data = sink.reserve(size);
+		if (data == nullptr) {
+			throw serialization_error("Serialization source is out of range.");
+		}
+
+		serialize_impl<T, Order>(obj, data);
+		sink.commit(size);
+	}
+
+	/**
+	 * Serialize data to sink in big endian.
+	 *
+	 * @param obj A object to serialize.
+	 * @param sink A destination sink which satisfies is_serialization_sink_v.
+	 * @tparam T The type of data to serialize.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <typename T, typename Sink>
+	auto serialize(const T& obj, Sink& sink) -> std::enable_if_t<is_serialization_sink_v<Sink>, void> {
+		serialize<byte_order::big>(obj, sink);
+	}
+
+	/**
+	 * Serialize contiguous objects to sink back to back.
+	 *
+	 * @param objects A source range which has data() and size() member function such as std::vector<T> and std::span<const T>.
+	 * @param sink A destination sink which satisfies is_serialization_sink_v.
+	 * @tparam Order The byte order of serialized data.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <byte_order Order, typename Range, typename Sink>
+	auto serialize_range(Range&& objects, Sink& sink) -> decltype(objects.data(), objects.size(),
+																	std::enable_if_t<is_serialization_sink_v<Sink>, void>()) {
+		using object_type = remove_cvref_t<decltype(*objects.data())>;
+		const auto count = static_cast<size_t>(objects.size());
+		// Reject counts whose total serialized size overflows size_t.
+		if (!is_in_serialized_range<object_type>(SIZE_MAX, 0, count)) {
+			throw serialization_error("Serialization source is out of range.");
+		}
+		// Reserve all objects at once so that containers are extended only once.
+		const auto size = serialized_size_v<object_type, Order> * count;
+		const auto data = sink.reserve(size);
+		if (data == nullptr) {
+			throw serialization_error("Serialization source is out of range.");
+		}
+
+		if (count > 0) {
+			serialize_array_impl<object_type, Order>(objects.data(), count, data);
+		}
+		sink.commit(size);
+	}
+
+	/**
+	 * Serialize contiguous objects to sink back to back in big endian.
+	 *
+	 * @param objects A source range which has data() and size() member function such as std::vector<T> and std::span<const T>.
+	 * @param sink A destination sink which satisfies is_serialization_sink_v.
+	 * @throw serialization_error Serialization is failed.
+	 */
+	template <typename Range, typename Sink>
+	auto serialize_range(Range&& objects, Sink& sink) -> decltype(objects.data(), objects.size(),
+																	std::enable_if_t<is_serialization_sink_v<Sink>, void>()) {
+		serialize_range<byte_order::big>(std::forward<Range>(objects), sink);
+	}
+
+	/**
+	 * Deserialize data from source.
+	 *
+	 * @param obj A object to deserialize.
+	 * @param source A source which satisfies is_deserialization_source_v.
+	 * @tparam Order The byte order of serialized data.
+	 * @tparam T The type of data to deserialize.
+	 * @throw serialization_error Deserialization is failed.
+	 */
+	template <byte_order Order, typename T, typename Source>
+	auto deserialize(T& obj, Source& source) -> std::enable_if_t<
+		!std::is_const_v<T> && is_deserialization_source_v<Source>, void> {
+		constexpr auto size = serialized_size_v<T, Order>;
+		const auto data = source.peek(size);
+		if (data == nullptr) {
+			throw serialization_error("Deserialization destination is out of range.");
+		}
+
+		deserialize_impl<T, Order>(obj, data);
+		source.consume(size);
+	}
+
+	/**
+	 * Deserialize data from source in big endian.
+	 *
+	 * @param obj A object to deserialize.
+	 * @param source A source which satisfies is_deserialization_source_v.
+	 * @tparam T The type of data to deserialize.
+	 * @throw serialization_error Deserialization is failed.
+	 */
+	template <typename T, typename Source>
+	auto deserialize(T& obj, Source& source) -> std::enable_if_t<
+		!std::is_const_v<T> && is_deserialization_source_v<Source>, void> {
+		deserialize<byte_order::big>(obj, source);
+	}
+
+	/**
+	 * Deserialize contiguous objects from source in which objects are serialized back to back.
+	 *
+	 * @param objects A destination range which has data() and size() member function such as std::vector<T> and std::span<T>.
+	 * @param source A source which satisfies is_deserialization_source_v.
+	 * @tparam Order The byte order of serialized data.
+	 * @throw serialization_error Deserialization is failed.
+	 */
+	template <byte_order Order, typename Range, typename Source>
+	auto deserialize_range(Range&& objects, Source& source) -> decltype(objects.data(), objects.size(),
+		std::enable_if_t<!std::is_const_v<std::remove_reference_t<decltype(*objects.data())>> &&
+						is_deserialization_source_v<Source>, void>()) {
+		using object_type = remove_cvref_t<decltype(*objects.data())>;
+		const auto count = static_cast<size_t>(objects.size());
+		// Reject counts whose total serialized size overflows size_t.
+		if (!is_in_serialized_range<object_type>(SIZE_MAX, 0, count)) {
+			throw serialization_error("Deserialization destination is out of range.");
+		}
+		const auto size = serialized_size_v<object_type, Order> * count;
+		const auto data = source.peek(size);
+		if (data == nullptr) {
+			throw serialization_error("Deserialization destination is out of range.");
+		}
+
+		if (count > 0) {
+			deserialize_array_impl<object_type, Order>(objects.data(), count, data);
+		}
+		source.consume(size);
+	}
+
+	/**
+	 * Deserialize contiguous objects from source in which objects are serialized back to back in big endian.
+	 *
+	 * @param objects A destination range which has data() and size() member function such as std::vector<T> and std::span<T>.
+	 * @param source A source which satisfies is_deserialization_source_v.
+	 * @throw serialization_error Deserialization is failed.
+	 */
+	template <typename Range, typename Source>
+	auto deserialize_range(Range&& objects, Source& source) -> decltype(objects.data(), objects.size(),
+		std::enable_if_t<!std::is_const_v<std::remove_reference_t<decltype(*objects.data())>> &&
+						is_deserialization_source_v<Source>, void>()) {
+		deserialize_range<byte_order::big>(std::forward<Range>(objects), source);
+	}
+}
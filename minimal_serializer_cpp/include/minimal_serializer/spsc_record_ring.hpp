@@ -0,0 +1,165 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "memory_utility.hpp"
+#include "serializer.hpp"
+
+namespace minimal_serializer {
+	/**
+	 * @brief A lock free ring buffer of slots for serialized records between one producer thread and one consumer thread.
+	 * Each slot is exactly serialized_size_v<T> bytes. The producer serializes records into claimed slots and the consumer deserializes or views them in place.
+	 * Only acquire and release atomic operations are used, and no memory is allocated after construction.
+	 * @tparam T The type of records.
+	 * @tparam Order The byte order of serialized data.
+	 */
+	template <typename T, byte_order Order = byte_order::big>
+	class spsc_record_ring final {
+	public:
+		/**
+		 * The serialized size of a record, which is the size of a slot.
+		 */
+		static constexpr size_t record_size = serialized_size_v<T, Order>;
+
+		/**
+		 * @brief Create a ring buffer.
+		 * @param capacity The number of slots. This is rounded up to a power of two.
+		 */
+		explicit spsc_record_ring(const size_t capacity) : capacity_(round_up_to_power_of_two(capacity)),
+															mask_(capacity_ - 1),
+															slots_(std::make_unique<uint8_t[]>(capacity_ * record_size)) {}
+
+		spsc_record_ring(const spsc_record_ring&) = delete;
+		spsc_record_ring(spsc_record_ring&&) = delete;
+		~spsc_record_ring() = default;
+		spsc_record_ring& operator=(const spsc_record_ring&) = delete;
+		spsc_record_ring& operator=(spsc_record_ring&&) = delete;
+
+		/**
+		 * @brief Get the number of slots.
+		 * @return The number of slots.
+		 */
+		[[nodiscard]] size_t capacity() const noexcept {
+			return capacity_;
+		}
+
+		/**
+		 * @brief Get the number of records in the ring buffer. The result may be outdated when other thread is operating.
+		 * @return The number of records.
+		 */
+		[[nodiscard]] size_t size() const noexcept {
+			const auto head = consumer_.head.load(std::memory_order_acquire);
+			return static_cast<size_t>(producer_.tail.load(std::memory_order_acquire) - head);
+		}
+
+		/**
+		 * @brief Claim a free slot to write a serialized record. This must be called only from the producer thread.
+		 * @return The pointer to the slot, or nullptr if the ring buffer is full. The same slot is returned until publish() is called.
+		 */
+		[[nodiscard]] uint8_t* try_claim() noexcept {
+			const auto tail = producer_.tail.load(std::memory_order_relaxed);
+			// Read the index of the consumer only when the cached one indicates full to reduce cache line transfers.
+			if (tail - producer_.cached_head == capacity_) {
+				producer_.cached_head = consumer_.head.load(std::memory_order_acquire);
+				if (tail - producer_.cached_head == capacity_) {
+					return nullptr;
+				}
+			}
+			return slot(tail);
+		}
+
+		/**
+		 * @brief Make the claimed slot visible to the consumer. This must be called only from the producer thread after try_claim() succeeds.
+		 */
+		void publish() noexcept {
+			producer_.tail.store(producer_.tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+		}
+
+		/**
+		 * @brief Serialize a record into a free slot and publish it. This must be called only from the producer thread.
+		 * @param obj A record to push.
+		 * @return Whether the record is pushed. This is false if the ring buffer is full.
+		 */
+		bool try_push(const T& obj) {
+			auto* data = try_claim();
+			if (data == nullptr) {
+				return false;
+			}
+			serialize_impl<T, Order>(obj, data);
+			publish();
+			return true;
+		}
+
+		/**
+		 * @brief Get the oldest published slot without removing it. This must be called only from the consumer thread.
+		 * @return The pointer to serialized data in the slot, or nullptr if the ring buffer is empty. The data is valid until release() is called.
+		 */
+		[[nodiscard]] const uint8_t* try_peek() noexcept {
+			const auto head = consumer_.head.load(std::memory_order_relaxed);
+			// Read the index of the producer only when the cached one indicates empty to reduce cache line transfers.
+			if (head == consumer_.cached_tail) {
+				consumer_.cached_tail = producer_.tail.load(std::memory_order_acquire);
+				if (head == consumer_.cached_tail) {
+					return nullptr;
+				}
+			}
+			return slot(head);
+		}
+
+		/**
+		 * @brief Return the peeked slot to the producer. This must be called only from the consumer thread after try_peek() succeeds.
+		 */
+		void release() noexcept {
+			consumer_.head.store(consumer_.head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+		}
+
+		/**
+		 * @brief Deserialize the oldest record and remove it. This must be called only from the consumer thread.
+		 * @param obj A destination object.
+		 * @return Whether a record is popped. This is false if the ring buffer is empty.
+		 */
+		bool try_pop(T& obj) {
+			const auto* data = try_peek();
+			if (data == nullptr) {
+				return false;
+			}
+			deserialize_impl<T, Order>(obj, data);
+			release();
+			return true;
+		}
+
+	private:
+		// Indices are not wrapped, and a slot is selected by masking lower bits. The indices of the producer and the consumer are placed on different cache lines.
+		struct alignas(cache_line_size) producer_state final {
+			std::atomic<uint64_t> tail{0};
+			uint64_t cached_head = 0;
+		};
+
+		struct alignas(cache_line_size) consumer_state final {
+			std::atomic<uint64_t> head{0};
+			uint64_t cached_tail = 0;
+		};
+
+		producer_state producer_;
+		consumer_state consumer_;
+		size_t capacity_;
+		size_t mask_;
+		std::unique_ptr<uint8_t[]> slots_;
+
+		[[nodiscard]] uint8_t* slot(const uint64_t index) const noexcept {
+			return slots_.get() + (index & mask_) * record_size;
+		}
+	};
+}
@@ -0,0 +1,121 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "serializer.hpp"
+
+namespace minimal_serializer {
+	/**
+	 * @brief An incremental decoder which accepts byte chunks of any size from pipes or sockets and emits complete records.
+	 * Records which are entirely in a chunk are deserialized directly from the chunk. Only the bytes of a record which straddles chunks are copied into a carry buffer of serialized_size_v<T> bytes.
+	 * @tparam T The type of records.
+	 * @tparam Order The byte order of serialized data.
+	 */
+	template <typename T, byte_order Order = byte_order::big>
+	class stream_decoder final {
+	public:
+		static_assert(std::is_default_constructible_v<T>, "The type of records must be default constructible.");
+
+		/**
+		 * The serialized size of a record.
+		 */
+		static constexpr size_t record_size = serialized_size_v<T, Order>;
+
+		stream_decoder() = default;
+
+		/**
+		 * @brief Decode records from a chunk of bytes which follows previously fed chunks.
+		 * @param data The pointer to the chunk.
+		 * @param size The size of the chunk.
+		 * @param func A function which is called with const T& for each completed record in order. The reference is valid only during the call.
+		 * @return The number of completed records.
+		 * @throw serialization_error Deserialization is failed. If func throws, the exception is propagated and the rest of the chunk is discarded.
+		 */
+		template <typename Func>
+		size_t feed(const uint8_t* data, size_t size, Func&& func) {
+			size_t count = 0;
+			// An empty chunk may have nullptr as its data, which must not be passed to memcpy.
+			if (size == 0) {
+				return count;
+			}
+			if (carry_size_ > 0) {
+				const auto copy_size = std::min(record_size - carry_size_, size);
+				std::memcpy(carry_.data() + carry_size_, data, copy_size);
+				carry_size_ += copy_size;
+				data += copy_size;
+				size -= copy_size;
+				if (carry_size_ < record_size) {
+					return count;
+				}
+				carry_size_ = 0;
+				emit(carry_.data(), func);
+				++count;
+			}
+
+			for (; size >= record_size; data += record_size, size -= record_size) {
+				emit(data, func);
+				++count;
+			}
+
+			if (size > 0) {
+				std::memcpy(carry_.data(), data, size);
+				carry_size_ = size;
+			}
+			return count;
+		}
+
+		/**
+		 * @brief Decode records from a chunk of bytes which follows previously fed chunks.
+		 * @param chunk A chunk which has data() and size() member function.
+		 * @param func A function which is called with const T& for each completed record in order. The reference is valid only during the call.
+		 * @return The number of completed records.
+		 * @throw serialization_error Deserialization is failed. If func throws, the exception is propagated and the rest of the chunk is discarded.
+		 */
+		template <typename Chunk, typename Func>
+		auto feed(const Chunk& chunk, Func&& func) -> decltype(chunk.data(), chunk.size(), size_t()) {
+			return feed(reinterpret_cast<const uint8_t*>(chunk.data()), static_cast<size_t>(chunk.size()),
+						std::forward<Func>(func));
+		}
+
+		/**
+		 * @brief Get the number of bytes of an incomplete record which are waiting for following chunks.
+		 * @return The number of bytes in the carry buffer.
+		 */
+		[[nodiscard]] size_t pending_size() const noexcept {
+			return carry_size_;
+		}
+
+		/**
+		 * @brief Discard the bytes of an incomplete record, for example when the connection is reset.
+		 */
+		void reset() noexcept {
+			carry_size_ = 0;
+		}
+
+	private:
+		serialized_data<T, Order> carry_;
+		size_t carry_size_ = 0;
+		// Reuse one object so that records are not constructed for each call.
+		T record_{};
+
+		template <typename Func>
+		void emit(const uint8_t* data, Func& func) {
+			deserialize_impl<T, Order>(record_, data);
+			func(static_cast<const T&>(record_));
+		}
+	};
+}
@@ -0,0 +1,266 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "memory_utility.hpp"
+
+namespace minimal_serializer {
+	/**
+	 * @brief A thread pool which executes chunks of a parallel loop with work stealing.
+	 * Each thread owns a contiguous range of chunks and takes chunks from the front of it. When a thread runs out of chunks, it steals chunks from the back of ranges of other threads.
+	 * The thread calling parallel_for() also participates in the loop.
+	 */
+	class thread_pool final {
+	public:
+		/**
+		 * @brief Create a thread pool.
+		 * @param thread_count The number of threads which execute parallel loops including the calling thread. If this is 0, the number of hardware threads is used.
+		 */
+		explicit thread_pool(size_t thread_count = 0) {
+			if (thread_count == 0) {
+				thread_count = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+			}
+
+			ranges_ = std::make_unique<chunk_range[]>(thread_count);
+			thread_count_ = thread_count;
+			workers_.reserve(thread_count - 1);
+			for (size_t i = 1; i < thread_count; ++i) {
+				workers_.emplace_back([this, i] { work(i); });
+			}
+		}
+
+		thread_pool(const thread_pool&) = delete;
+		thread_pool(thread_pool&&) = delete;
+
+		~thread_pool() {
+			{
+				std::lock_guard lock(mutex_);
+				stopped_ = true;
+			}
+			job_condition_.notify_all();
+			for (auto& worker : workers_) {
+				worker.join();
+			}
+		}
+
+		thread_pool& operator=(const thread_pool&) = delete;
+		thread_pool& operator=(thread_pool&&) = delete;
+
+		/**
+		 * @brief Get the number of threads which execute parallel loops including the calling thread.
+		 * @return The number of threads.
+		 */
+		[[nodiscard]] size_t thread_count() const noexcept {
+			return thread_count_;
+		}
+
+		/**
+		 * @brief Call a function for each chunk index in [0, chunk_count) in parallel and wait for all calls to finish.
+		 * If some calls throw exceptions, the first one is rethrown after all calls finish.
+		 * If this is called from a function running in a loop of this pool, the nested loop is executed in the calling thread because all threads of the pool are busy.
+		 * Loops which call each other through different pools are not supported because they wait for each other.
+		 * @param chunk_count The number of chunks.
+		 * @param func A function which is called with a chunk index.
+		 */
+		template <typename Func>
+		void parallel_for(const size_t chunk_count, Func&& func) {
+			if (chunk_count == 0) {
+				return;
+			}
+			if (chunk_count > 0xffffffff) {
+				throw std::length_error("The number of chunks must be less than 2^32.");
+			}
+			if (thread_count_ == 1 || chunk_count == 1 || is_executing_in_this_pool()) {
+				for (size_t i = 0; i < chunk_count; ++i) {
+					func(i);
+				}
+				return;
+			}
+
+			// Only one loop is executed at a time in a pool.
+			std::lock_guard job_lock(job_mutex_);
+			using func_t = std::remove_reference_t<Func>;
+			context_ = const_cast<void*>(static_cast<const void*>(&func));
+			invoke_ = [](void* context, const size_t index) { (*static_cast<func_t*>(context))(index); };
+			first_exception_ = nullptr;
+			has_exception_.store(false, std::memory_order_relaxed);
+
+			// Distribute chunks evenly in advance. Unbalanced loads are handled by stealing.
+			for (size_t i = 0; i < thread_count_; ++i) {
+				const auto begin = chunk_count * i / thread_count_;
+				const auto end = chunk_count * (i + 1) / thread_count_;
+				ranges_[i].range.store(pack_range(begin, end), std::memory_order_relaxed);
+			}
+
+			{
+				std::lock_guard lock(mutex_);
+				running_workers_ = workers_.size();
+				++generation_;
+			}
+			job_condition_.notify_all();
+
+			execute(0);
+
+			std::unique_lock lock(mutex_);
+			finish_condition_.wait(lock, [this] { return running_workers_ == 0; });
+			if (first_exception_) {
+				std::rethrow_exception(first_exception_);
+			}
+		}
+
+	private:
+		// A stack of pools executing chunks in the current thread to detect nested loops, which would wait for chunks that only the waiting threads can take.
+		struct execution_scope final {
+			const thread_pool* pool;
+			const execution_scope* parent;
+		};
+
+		inline static thread_local const execution_scope* current_scope_ = nullptr;
+
+		// Begin and end of chunk indices packed into one atomic variable to take chunks from both sides with compare and exchange.
+		struct alignas(cache_line_size) chunk_range final {
+			std::atomic<uint64_t> range{0};
+		};
+
+		std::unique_ptr<chunk_range[]> ranges_;
+		size_t thread_count_;
+		std::vector<std::thread> workers_;
+
+		std::mutex job_mutex_;
+		std::mutex mutex_;
+		std::condition_variable job_condition_;
+		std::condition_variable finish_condition_;
+		uint64_t generation_ = 0;
+		size_t running_workers_ = 0;
+		bool stopped_ = false;
+
+		void* context_ = nullptr;
+		void (*invoke_)(void*, size_t) = nullptr;
+		std::exception_ptr first_exception_;
+		std::atomic<bool> has_exception_{false};
+
+		static constexpr uint64_t pack_range(const uint64_t begin, const uint64_t end) {
+			return begin << 32 | end;
+		}
+
+		// Take a chunk from the front of own range.
+		bool pop_front(const size_t owner, size_t& index) {
+			auto& range = ranges_[owner].range;
+			auto current = range.load(std::memory_order_relaxed);
+			while (true) {
+				const auto begin = current >> 32;
+				const auto end = current & 0xffffffff;
+				if (begin >= end) {
+					return false;
+				}
+				if (range.compare_exchange_weak(current, pack_range(begin + 1, end), std::memory_order_acq_rel)) {
+					index = static_cast<size_t>(begin);
+					return true;
+				}
+			}
+		}
+
+		// Take a chunk from the back of the range of other thread.
+		bool steal_back(const size_t victim, size_t& index) {
+			auto& range = ranges_[victim].range;
+			auto current = range.load(std::memory_order_relaxed);
+			while (true) {
+				const auto begin = current >> 32;
+				const auto end = current & 0xffffffff;
+				if (begin >= end) {
+					return false;
+				}
+				if (range.compare_exchange_weak(current, pack_range(begin, end - 1), std::memory_order_acq_rel)) {
+					index = static_cast<size_t>(end - 1);
+					return true;
+				}
+			}
+		}
+
+		[[nodiscard]] bool is_executing_in_this_pool() const noexcept {
+			for (auto scope = current_scope_; scope != nullptr; scope = scope->parent) {
+				if (scope->pool == this) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void execute(const size_t self) {
+			const execution_scope scope{this, current_scope_};
+			current_scope_ = &scope;
+			execute_chunks(self);
+			current_scope_ = scope.parent;
+		}
+
+		void execute_chunks(const size_t self) {
+			size_t index;
+			while (true) {
+				auto found = pop_front(self, index);
+				for (size_t i = 1; !found && i < thread_count_; ++i) {
+					found = steal_back((self + i) % thread_count_, index);
+				}
+				if (!found) {
+					return;
+				}
+				// Skip remaining chunks after an exception occurs.
+				if (has_exception_.load(std::memory_order_relaxed)) {
+					continue;
+				}
+
+				try {
+					invoke_(context_, index);
+				}
+				catch (...) {
+					std::lock_guard lock(mutex_);
+					if (!first_exception_) {
+						first_exception_ = std::current_exception();
+					}
+					has_exception_.store(true, std::memory_order_relaxed);
+				}
+			}
+		}
+
+		void work(const size_t self) {
+			uint64_t last_generation = 0;
+			while (true) {
+				{
+					std::unique_lock lock(mutex_);
+					job_condition_.wait(lock, [&] { return stopped_ || generation_ != last_generation; });
+					if (stopped_) {
+						return;
+					}
+					last_generation = generation_;
+				}
+
+				execute(self);
+
+				{
+					std::lock_guard lock(mutex_);
+					--running_workers_;
+				}
+				finish_condition_.notify_one();
+			}
+		}
+	};
+}
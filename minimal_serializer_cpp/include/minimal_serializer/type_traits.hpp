@@ -10,6 +10,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #pragma once
 
+#include <array>
+#include <iterator>
 #include <type_traits>
 #include <tuple>
 
@@ -53,6 +55,19 @@ namespace minimal_serializer {
 	using member_variable_pointer_variable_t = typename decltype(minimal_serializer::member_variable_pointer_t_impl(P)
 	)::second_type;
 
+	/**
+	 * @brief Whether two member variable pointers indicate the same member. Pointers of different types are always different.
+	 */
+	template <auto P1, auto P2>
+	constexpr bool is_same_member_variable_pointer() {
+		if constexpr (std::is_same_v<decltype(P1), decltype(P2)>) {
+			return P1 == P2;
+		}
+		else {
+			return false;
+		}
+	}
+
 	/**
 	 * @brief A container to hold member variable pointer which are serialize target.
 	 * @tparam FirstPtr A member function pointer which is serialize target.
@@ -90,6 +105,47 @@ namespace minimal_serializer {
 		static reference_types get_reference_tuple(class_type& obj) {
 			return std::tie(obj.*FirstPtr, obj.*RestPtrs...);
 		}
+
+		/**
+		 * @brief Get the index of a member variable pointer in targets.
+		 * @tparam Ptr A member variable pointer to find.
+		 * @return The index of Ptr, or the number of targets if Ptr is not a target.
+		 */
+		template <auto Ptr>
+		static constexpr size_t get_index() {
+			constexpr bool matches[] = {
+				is_same_member_variable_pointer<Ptr, FirstPtr>(), is_same_member_variable_pointer<Ptr, RestPtrs>()...
+			};
+			for (size_t i = 0; i < std::size(matches); ++i) {
+				if (matches[i]) {
+					return i;
+				}
+			}
+			return std::size(matches);
+		}
+
+		/**
+		 * @brief Check whether targets cover all bytes of class_type in declaration order without padding. class_type must be a trivial type.
+		 * @return Whether the object representation of class_type is a sequence of targets.
+		 */
+		static constexpr bool is_dense_in_declaration_order() {
+			constexpr auto targets_size = (sizeof(member_variable_pointer_variable_t<FirstPtr>) + ... + sizeof(
+				member_variable_pointer_variable_t<RestPtrs>));
+			if constexpr (targets_size != sizeof(class_type)) {
+				return false;
+			}
+			else {
+				// Addresses of members in a same object are comparable in compile time.
+				const class_type obj{};
+				const void* const addresses[] = {&(obj.*FirstPtr), &(obj.*RestPtrs)...};
+				for (size_t i = 1; i <= sizeof...(RestPtrs); ++i) {
+					if (!(addresses[i - 1] < addresses[i])) {
+						return false;
+					}
+				}
+				return true;
+			}
+		}
 	};
 
 	/**
@@ -196,6 +252,62 @@ namespace minimal_serializer {
 	template <typename T>
 	constexpr bool is_serializable_custom_type_v = std::is_trivial_v<T> && has_serialize_targets_definition_v<T>;
 
+	/**
+	 * @brief A tag to pack bool and enum serialize targets whose bit width is specified into bits. Use this as serialize_packing of a custom type.
+	 */
+	struct bit_packing final {};
+
+	/**
+	 * @brief A template meta function to get serialize packing type alias defined in the type.
+	 * This returns T::serialize_packing if it is defined, or returns void if it is not.
+	 */
+	struct get_serialize_packing_impl final {
+		template <typename T>
+		static auto check(T&& x) -> typename T::serialize_packing;
+
+		template <typename T>
+		static auto check(...) -> void;
+	};
+
+	/**
+	 * @brief A packing definition of serialize targets. The type will be void if T does not have serialize_packing type alias. This struct may be specialized for custom class.
+	 * @tparam T A target type.
+	 */
+	template <typename T>
+	struct serialize_packing {
+		using type = decltype(get_serialize_packing_impl::check<T>(std::declval<T>()));
+	};
+
+	/**
+	 * @brief A packing definition type alias of serialize targets.
+	 * @tparam T A target type.
+	 */
+	template <typename T>
+	using serialize_packing_t = typename serialize_packing<T>::type;
+
+	/**
+	 * @brief Whether serialize targets of a custom type are bit packed.
+	 * @tparam T A target type.
+	 */
+	template <typename T>
+	constexpr bool is_bit_packed_v = is_serializable_custom_type_v<T> && std::is_same_v<serialize_packing_t<T>, bit_packing>;
+
+	/**
+	 * @brief The number of bits of a serialize target in bit packed custom types. 0 means that the target is not packed and serialized in bytes.
+	 * This is 1 for bool and 0 for others. Specialize this struct for enums to pack them.
+	 * Values must be in [0, 2^bits), or in [-2^(bits-1), 2^(bits-1)) if the underlying type is signed. Upper bits out of the width are dropped.
+	 * @tparam T A target type.
+	 */
+	template <typename T>
+	struct serialized_bit_width : std::integral_constant<size_t, std::is_same_v<T, bool> ? 1 : 0> {};
+
+	/**
+	 * @brief The number of bits of a serialize target in bit packed custom types. If T has const, volatile and/or reference, they will be removed.
+	 * @tparam T A target type.
+	 */
+	template <typename T>
+	constexpr size_t serialized_bit_width_v = serialized_bit_width<remove_cvref_t<T>>::value;
+
 	/**
 	 * @brief Whether a type is serializable.
 	 */
@@ -207,6 +319,60 @@ namespace minimal_serializer {
 		is_serializable_boost_static_string_v<T> ||
 		is_serializable_custom_type_v<T>;
 
+	template <typename T>
+	struct is_std_array final : std::false_type {};
+
+	template <typename T, size_t N>
+	struct is_std_array<std::array<T, N>> final : std::true_type {};
+
+	/**
+	 * @brief Whether the type is std::array.
+	 */
+	template <typename T>
+	constexpr bool is_std_array_v = is_std_array<T>::value;
+
+	template <typename T>
+	constexpr bool is_serialized_layout_compatible_impl();
+
+	template <typename T, size_t... I>
+	constexpr bool is_serialized_layout_compatible_tuple_impl(std::index_sequence<I...>) {
+		return (is_serialized_layout_compatible_impl<std::tuple_element_t<I, T>>() && ...);
+	}
+
+	template <typename T>
+	constexpr bool is_serialized_layout_compatible_impl() {
+		if constexpr (is_serializable_builtin_type_v<T> || is_serializable_enum_v<T>) {
+			return true;
+		}
+		else if constexpr (is_std_array_v<T>) {
+			using element_type = typename T::value_type;
+			return sizeof(T) == sizeof(element_type) * std::tuple_size_v<T> &&
+				is_serialized_layout_compatible_impl<element_type>();
+		}
+		else if constexpr (is_serializable_custom_type_v<T> && !is_bit_packed_v<T>) {
+			using targets = serialize_targets_t<T>;
+			using target_types = typename targets::types;
+			if constexpr (is_serialized_layout_compatible_tuple_impl<target_types>(
+				std::make_index_sequence<std::tuple_size_v<target_types>>{})) {
+				return targets::is_dense_in_declaration_order();
+			}
+			else {
+				return false;
+			}
+		}
+		else {
+			// The layout of std::tuple and std::pair is implementation defined, strings have extra data such as size, and bit packed types have bit fields.
+			return false;
+		}
+	}
+
+	/**
+	 * @brief Whether serialized data of the type is same as the object representation of it except for byte order.
+	 * This is true for arithmetic types, enums, std::array of such types and custom types whose serialize targets cover all members in declaration order without padding.
+	 */
+	template <typename T>
+	constexpr bool is_serialized_layout_compatible_v = is_serialized_layout_compatible_impl<remove_cvref_t<T>>();
+
 #if __cpp_concepts
 	/**
 	 * @brief A concept to constrain types to serializable.
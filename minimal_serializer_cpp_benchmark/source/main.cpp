@@ -28,6 +28,9 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include "minimal_serializer/serializer.hpp"
 
+#include "queue_benchmark.hpp"
+#include "record_writer_benchmark.hpp"
+
 struct data {
 	bool boolean;
 	uint32_t unsigned_number;
@@ -53,7 +56,7 @@ struct data2 {
 	uint32_t unsigned_number;
 	int64_t number;
 	std::array<int32_t, 16> array;
-	data data;
+	::data data;
 
 	template <class Archive>
 	void serialize(Archive& ar, const unsigned int version) {
@@ -75,7 +78,7 @@ struct data3 {
 	uint32_t unsigned_number;
 	int64_t number;
 	std::array<int32_t, 16> array;
-	data2 data2;
+	::data2 data2;
 
 	template <class Archive>
 	void serialize(Archive& ar, const unsigned int version) {
@@ -367,5 +370,7 @@ void speed_benchmark() {
 int main() {
 	size_benchmark();
 	speed_benchmark();
+	queue_benchmark();
+	record_writer_benchmark();
 	return 0;
 }
@@ -0,0 +1,129 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "queue_benchmark.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "minimal_serializer/mpmc_record_queue.hpp"
+
+namespace {
+	struct record {
+		uint64_t sequence;
+		uint32_t producer;
+		std::array<int32_t, 8> payload;
+
+		using serialize_targets = minimal_serializer::serialize_target_container<
+			&record::sequence, &record::producer, &record::payload>;
+	};
+
+	// A range of records which has data() and size() for batch operations without copy.
+	struct record_range {
+		const record* first;
+		size_t count;
+
+		[[nodiscard]] const record* data() const { return first; }
+		[[nodiscard]] size_t size() const { return count; }
+	};
+
+	// Push and pop records in one thread alternately as a baseline without contention, and return the duration in milli seconds.
+	long long measure_queue_single_thread(const size_t record_count, const size_t batch_size) {
+		minimal_serializer::mpmc_record_queue<record> queue(1024);
+		std::vector<record> batch(batch_size);
+		const auto start_time = std::chrono::system_clock::now();
+		for (size_t i = 0; i < record_count; i += batch_size) {
+			if (batch_size == 1) {
+				queue.try_push(batch[0]);
+				queue.try_pop(batch[0]);
+			}
+			else {
+				queue.try_push_batch(batch);
+				queue.try_pop_batch(batch);
+			}
+		}
+		const auto end_time = std::chrono::system_clock::now();
+		return std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+	}
+
+	// Push records_per_thread records in each of producer_count producers and pop them in the same number of consumers, and return the duration in milli seconds.
+	long long measure_queue(const size_t producer_count, const size_t records_per_thread, const size_t batch_size) {
+		minimal_serializer::mpmc_record_queue<record> queue(1024);
+		std::atomic<bool> start{false};
+		std::vector<std::thread> threads;
+
+		for (size_t p = 0; p < producer_count; ++p) {
+			threads.emplace_back([&, p] {
+				std::vector<record> batch(batch_size, record{0, static_cast<uint32_t>(p), {}});
+				while (!start.load(std::memory_order_acquire)) {}
+				for (size_t i = 0; i < records_per_thread; i += batch_size) {
+					size_t pushed = 0;
+					while (pushed < batch_size) {
+						const auto count = batch_size == 1
+												? (queue.try_push(batch[0]) ? 1 : 0)
+												: queue.try_push_batch(record_range{batch.data() + pushed, batch_size - pushed});
+						if (count == 0) {
+							// Give other threads a chance to run when threads are more than cores.
+							std::this_thread::yield();
+						}
+						pushed += count;
+					}
+				}
+			});
+		}
+
+		// Consumers pop until all records are popped because a consumer may pop more records than a producer pushes.
+		const auto total_records = producer_count * records_per_thread;
+		std::atomic<size_t> total_popped{0};
+		for (size_t c = 0; c < producer_count; ++c) {
+			threads.emplace_back([&] {
+				std::vector<record> batch(batch_size);
+				while (!start.load(std::memory_order_acquire)) {}
+				while (total_popped.load(std::memory_order_relaxed) < total_records) {
+					const auto popped = batch_size == 1 ? (queue.try_pop(batch[0]) ? 1 : 0) : queue.try_pop_batch(batch);
+					if (popped > 0) {
+						total_popped.fetch_add(popped, std::memory_order_relaxed);
+					}
+					else {
+						std::this_thread::yield();
+					}
+				}
+			});
+		}
+
+		const auto start_time = std::chrono::system_clock::now();
+		start.store(true, std::memory_order_release);
+		for (auto& thread : threads) {
+			thread.join();
+		}
+		const auto end_time = std::chrono::system_clock::now();
+		return std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+	}
+}
+
+void queue_benchmark() {
+	std::cout << "===Minimal Serializer MPMC Record Queue===" << std::endl;
+	constexpr size_t total_records = 1024 * 1024;
+	for (size_t thread_count = 1; thread_count <= 64; thread_count *= 2) {
+		// Half of threads are producers and the others are consumers.
+		const auto producer_count = thread_count / 2;
+		for (const size_t batch_size : {1, 16}) {
+			const auto duration = thread_count == 1
+									? measure_queue_single_thread(total_records, batch_size)
+									: measure_queue(producer_count, total_records / producer_count, batch_size);
+			std::cout << thread_count << " threads, batch size " << batch_size << ": " << duration <<
+				" milli seconds for " << total_records << " records." << std::endl;
+		}
+	}
+}
@@ -0,0 +1,155 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "record_writer_benchmark.hpp"
+
+#include <iostream>
+
+#include "minimal_serializer/record_writer.hpp"
+
+#ifdef MINIMAL_SERIALIZER_POSIX_IO
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+	struct record {
+		uint64_t sequence;
+		uint32_t source;
+		std::array<int32_t, 8> payload;
+
+		using serialize_targets = minimal_serializer::serialize_target_container<
+			&record::sequence, &record::source, &record::payload>;
+	};
+
+	// A temporary file which is removed at the end of the scope.
+	class temporary_file final {
+	public:
+		temporary_file() : path_(make_path()), fd_(::mkstemp(path_.data())) {
+			if (fd_ < 0) {
+				minimal_serializer::throw_last_system_error("Failed to create a temporary file.");
+			}
+		}
+
+		temporary_file(const temporary_file&) = delete;
+		temporary_file(temporary_file&&) = delete;
+
+		~temporary_file() {
+			::close(fd_);
+			::unlink(path_.c_str());
+		}
+
+		temporary_file& operator=(const temporary_file&) = delete;
+		temporary_file& operator=(temporary_file&&) = delete;
+
+		[[nodiscard]] const std::string& path() const noexcept {
+			return path_;
+		}
+
+		[[nodiscard]] int fd() const noexcept {
+			return fd_;
+		}
+
+	private:
+		std::string path_;
+		int fd_;
+
+		static std::string make_path() {
+			const auto directory = std::getenv("TMPDIR");
+			return std::string(directory == nullptr ? "/tmp" : directory) + "/record_writer_benchmark_XXXXXX";
+		}
+	};
+
+	// Run func and return the duration in milli seconds.
+	template <typename Func>
+	long long measure(Func&& func) {
+		const auto start_time = std::chrono::steady_clock::now();
+		func();
+		const auto end_time = std::chrono::steady_clock::now();
+		return std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+	}
+
+	void print_result(const char* name, const long long duration, const size_t record_count) {
+		constexpr auto record_size = minimal_serializer::serialized_size_v<record>;
+		const auto megabytes = static_cast<double>(record_count * record_size) / (1024 * 1024);
+		std::cout << name << ": " << duration << " milli seconds for " << record_count << " records (" <<
+			(duration == 0 ? 0.0 : megabytes * 1000 / static_cast<double>(duration)) << " MiB/s)." << std::endl;
+	}
+}
+
+void record_writer_benchmark() {
+	std::cout << "===Minimal Serializer Record Writer===" << std::endl;
+	constexpr size_t record_count = 4 * 1024 * 1024;
+	std::vector<record> records(record_count);
+	for (size_t i = 0; i < record_count; ++i) {
+		records[i] = {i, static_cast<uint32_t>(i % 16), {}};
+	}
+
+	{
+		temporary_file file;
+		const auto duration = measure([&] {
+			std::ofstream stream(file.path(), std::ios::binary);
+			for (const auto& r : records) {
+				const auto data = minimal_serializer::serialize(r);
+				stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+			}
+		});
+		print_result("std::ofstream per record", duration, record_count);
+	}
+
+	{
+		// A write system call for each record is much slower, so measure fewer records.
+		constexpr size_t count = record_count / 16;
+		temporary_file file;
+		const auto duration = measure([&] {
+			for (size_t i = 0; i < count; ++i) {
+				auto data = minimal_serializer::serialize(records[i]);
+				iovec iov{data.data(), data.size()};
+				minimal_serializer::write_all(file.fd(), &iov, 1);
+			}
+		});
+		print_result("write per record", duration, count);
+	}
+
+	for (const size_t buffer_size : {size_t{64} * 1024, size_t{1024} * 1024, size_t{16} * 1024 * 1024}) {
+		temporary_file file;
+		const auto duration = measure([&] {
+			minimal_serializer::record_writer<record> writer(file.fd(), {buffer_size});
+			for (const auto& r : records) {
+				writer.write(r);
+			}
+			writer.flush();
+		});
+		const auto name = "record_writer::write, buffer " + std::to_string(buffer_size / 1024) + " KiB";
+		print_result(name.c_str(), duration, record_count);
+	}
+
+	{
+		temporary_file file;
+		const auto duration = measure([&] {
+			minimal_serializer::record_writer<record> writer(file.fd());
+			writer.write_range(records);
+			writer.flush();
+		});
+		print_result("record_writer::write_range, buffer 1024 KiB", duration, record_count);
+	}
+}
+#else
+void record_writer_benchmark() {
+	std::cout << "===Minimal Serializer Record Writer===" << std::endl;
+	std::cout << "record_writer is not available on this platform." << std::endl;
+}
+#endif
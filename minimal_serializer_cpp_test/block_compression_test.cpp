@@ -0,0 +1,291 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "minimal_serializer/block_compression.hpp"
+#include "serialize_test_types.hpp"
+
+using namespace std;
+using namespace minimal_serializer;
+
+namespace {
+	using record_t = std::tuple<uint32_t, fixed_string_t<32>>;
+	using output_t = std::vector<uint8_t>;
+
+	std::vector<uint8_t> get_random_bytes(const size_t size) {
+		std::mt19937 engine(12345);
+		std::uniform_int_distribution<int> distribution(0, 255);
+		std::vector<uint8_t> data(size);
+		for (auto& value : data) {
+			value = static_cast<uint8_t>(distribution(engine));
+		}
+		return data;
+	}
+
+	std::vector<record_t> get_records(const size_t count) {
+		std::vector<record_t> records;
+		for (size_t i = 0; i < count; ++i) {
+			records.emplace_back(static_cast<uint32_t>(i * 3), fixed_string_t<32>(i % 2 == 0 ? u8"even" : u8"odd"));
+		}
+		return records;
+	}
+
+	template <typename Codec = lz_block_codec>
+	output_t write_records(const std::vector<record_t>& records, const size_t records_per_block, Codec codec = Codec()) {
+		block_writer<record_t, Codec> writer(records_per_block, std::move(codec));
+		output_t output;
+		container_sink sink(output);
+		for (const auto& record : records) {
+			writer.append(record, sink);
+		}
+		writer.finish(sink);
+		return output;
+	}
+
+	// A sink which appends to a container up to a limit.
+	class bounded_sink final {
+	public:
+		bounded_sink(output_t& output, const size_t limit) : sink_(output), output_(output), limit_(limit) {}
+
+		uint8_t* reserve(const size_t size) {
+			return output_.size() + size > limit_ ? nullptr : sink_.reserve(size);
+		}
+
+		void commit(const size_t size) {
+			sink_.commit(size);
+		}
+
+		void set_limit(const size_t limit) noexcept {
+			limit_ = limit;
+		}
+
+	private:
+		container_sink<output_t> sink_;
+		output_t& output_;
+		size_t limit_;
+	};
+
+	// A codec which counts calls to check that only requested blocks are decompressed.
+	class counting_codec final {
+	public:
+		explicit counting_codec(size_t& decompress_count) : decompress_count_(&decompress_count) {}
+
+		static constexpr size_t max_compressed_size(const size_t size) noexcept {
+			return lz_block_codec::max_compressed_size(size);
+		}
+
+		size_t compress(const uint8_t* source, const size_t size, uint8_t* destination) noexcept {
+			return codec_.compress(source, size, destination);
+		}
+
+		void decompress(const uint8_t* source, const size_t source_size, uint8_t* destination,
+						const size_t destination_size) const {
+			++*decompress_count_;
+			codec_.decompress(source, source_size, destination, destination_size);
+		}
+
+	private:
+		size_t* decompress_count_;
+		lz_block_codec codec_;
+	};
+}
+
+BOOST_AUTO_TEST_SUITE(block_compression_test)
+	BOOST_AUTO_TEST_CASE(test_lz_codec_round_trip) {
+		std::vector<uint8_t> pattern(10000);
+		for (size_t i = 0; i < pattern.size(); ++i) {
+			pattern[i] = static_cast<uint8_t>(i % 7 * 31);
+		}
+		auto mixed = get_random_bytes(3000);
+		mixed.resize(9000, 0);
+		mixed.insert(mixed.end(), pattern.begin(), pattern.begin() + 500);
+
+		const std::vector<std::vector<uint8_t>> sources{
+			{}, {1, 2, 3}, std::vector<uint8_t>(10000, 0), get_random_bytes(5000), pattern, mixed
+		};
+		lz_block_codec codec;
+		for (const auto& source : sources) {
+			std::vector<uint8_t> compressed(lz_block_codec::max_compressed_size(source.size()));
+			const auto size = codec.compress(source.data(), source.size(), compressed.data());
+			BOOST_CHECK_LE(size, compressed.size());
+
+			std::vector<uint8_t> actual(source.size() + 1);
+			codec.decompress(compressed.data(), size, actual.data(), source.size());
+			BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.begin() + source.size(), source.begin(), source.end());
+			if (!source.empty()) {
+				BOOST_CHECK_THROW(codec.decompress(compressed.data(), size, actual.data(), source.size() - 1), serialization_error);
+			}
+			BOOST_CHECK_THROW(codec.decompress(compressed.data(), size, actual.data(), source.size() + 1), serialization_error);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(test_lz_codec_compress_repetitive_data) {
+		lz_block_codec codec;
+		const std::vector<uint8_t> zeros(10000, 0);
+		std::vector<uint8_t> compressed(lz_block_codec::max_compressed_size(zeros.size()));
+		BOOST_CHECK_LT(codec.compress(zeros.data(), zeros.size(), compressed.data()), 64u);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_lz_codec_decompress_malformed_data) {
+		const std::vector<std::vector<uint8_t>> sources{
+			// Empty
+			{},
+			// Missing literals
+			{0x20, 1},
+			// Missing extended literal length
+			{0xf0},
+			// Offset 0
+			{0x10, 1, 0, 0},
+			// Offset before the top
+			{0x10, 1, 2, 0},
+			// Truncated offset
+			{0x10, 1, 1},
+		};
+		lz_block_codec codec;
+		std::vector<uint8_t> destination(16);
+		for (const auto& source : sources) {
+			BOOST_CHECK_THROW(codec.decompress(source.data(), source.size(), destination.data(), destination.size()),
+							serialization_error);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(test_write_read_records) {
+		for (const size_t count : {size_t{0}, size_t{1}, size_t{64}, size_t{65}, size_t{1000}}) {
+			const auto records = get_records(count);
+			const auto output = write_records(records, 64);
+
+			block_reader<record_t> reader(output);
+			BOOST_CHECK_EQUAL(reader.record_count(), count);
+			BOOST_CHECK_EQUAL(reader.records_per_block(), 64u);
+			BOOST_CHECK_EQUAL(reader.index().size(), (count + 63) / 64);
+			// Read in reverse order to seek blocks.
+			for (size_t i = count; i-- > 0;) {
+				record_t actual;
+				reader.read(i, actual);
+				BOOST_CHECK(actual == records[i]);
+			}
+			record_t actual;
+			BOOST_CHECK_THROW(reader.read(count, actual), std::out_of_range);
+			BOOST_CHECK_THROW(reader.block_data(reader.index().size()), std::out_of_range);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(test_compress_padded_strings) {
+		const auto records = get_records(1000);
+		const auto output = write_records(records, 256);
+		BOOST_CHECK_LT(output.size() * 4, records.size() * serialized_size_v<record_t>);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_store_incompressible_blocks) {
+		block_writer<uint64_t> writer(16);
+		output_t output;
+		container_sink sink(output);
+		std::mt19937_64 engine(12345);
+		for (size_t i = 0; i < 40; ++i) {
+			writer.append(engine(), sink);
+		}
+		writer.finish(sink);
+
+		block_reader<uint64_t> reader(output);
+		const std::vector<size_t> expected_sizes{128, 128, 64};
+		std::vector<size_t> actual_sizes;
+		for (const auto& entry : reader.index()) {
+			actual_sizes.push_back(entry.compressed_size);
+		}
+		BOOST_CHECK_EQUAL_COLLECTIONS(actual_sizes.begin(), actual_sizes.end(), expected_sizes.begin(), expected_sizes.end());
+
+		engine.seed(12345);
+		for (size_t i = 0; i < 40; ++i) {
+			uint64_t actual;
+			reader.read(i, actual);
+			BOOST_CHECK_EQUAL(actual, engine());
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(test_custom_codec) {
+		size_t decompress_count = 0;
+		const auto records = get_records(1000);
+		const auto output = write_records(records, 100, counting_codec(decompress_count));
+
+		block_reader<record_t, counting_codec> reader(output, counting_codec(decompress_count));
+		for (size_t i = 300; i < 400; ++i) {
+			record_t actual;
+			reader.read(i, actual);
+			BOOST_CHECK(actual == records[i]);
+		}
+		BOOST_CHECK_EQUAL(decompress_count, 1u);
+
+		// Blocks written by store_block_codec have no compressed block.
+		const auto stored_output = write_records(records, 100, store_block_codec());
+		block_reader<record_t, store_block_codec> stored_reader(stored_output);
+		record_t actual;
+		stored_reader.read(999, actual);
+		BOOST_CHECK(actual == records[999]);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_write_to_small_buffer) {
+		block_writer<uint64_t> writer(4);
+		std::array<uint8_t, 16> buffer{};
+		buffer_sink sink(buffer);
+		writer.append(1, sink);
+		BOOST_CHECK_THROW(writer.finish(sink), serialization_error);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_append_after_sink_is_full) {
+		block_writer<uint64_t> writer(4);
+		output_t output;
+		bounded_sink sink(output, 16);
+		for (uint64_t i = 0; i < 4; ++i) {
+			writer.append(i, sink);
+		}
+		// The full block cannot be written at the block boundary, so the record is not appended.
+		BOOST_CHECK_THROW(writer.append(4, sink), serialization_error);
+		BOOST_CHECK_THROW(writer.append(4, sink), serialization_error);
+		BOOST_CHECK(output.empty());
+
+		// Retry the same record after the sink has space.
+		sink.set_limit(1024);
+		writer.append(4, sink);
+		writer.finish(sink);
+		block_reader<uint64_t> reader(output);
+		BOOST_REQUIRE_EQUAL(reader.record_count(), 5u);
+		for (uint64_t i = 0; i < 5; ++i) {
+			uint64_t actual;
+			reader.read(i, actual);
+			BOOST_CHECK_EQUAL(actual, i);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(test_read_malformed_output) {
+		const auto output = write_records(get_records(100), 16);
+		// Too short
+		BOOST_CHECK_THROW((block_reader<record_t>(output.data(), 4)), serialization_error);
+		// Other record type
+		BOOST_CHECK_THROW(block_reader<uint64_t>{output}, serialization_error);
+		// Broken magic number
+		auto broken = output;
+		broken.back() ^= 1;
+		BOOST_CHECK_THROW(block_reader<record_t>{broken}, serialization_error);
+		// Truncated block
+		broken = output;
+		const auto index_offset = output.size() - serialized_size_v<block_footer> - 7 * serialized_size_v<block_index_entry>;
+		const std::array<uint8_t, 4> compressed_size{0, 0, 0, 1};
+		std::copy(compressed_size.begin(), compressed_size.end(), broken.begin() + index_offset + 8);
+		block_reader<record_t> reader(broken);
+		record_t actual;
+		BOOST_CHECK_THROW(reader.read(0, actual), serialization_error);
+	}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,62 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <array>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/mpl/list.hpp>
+#include <boost/mpl/int.hpp>
+
+#include "minimal_serializer/byte_swap.hpp"
+#include "minimal_serializer/serializer.hpp"
+
+using namespace std;
+using namespace minimal_serializer;
+
+using byte_swap_sizes = boost::mpl::list<boost::mpl::int_<1>, boost::mpl::int_<2>, boost::mpl::int_<4>, boost::mpl::int_<8>>;
+
+BOOST_AUTO_TEST_SUITE(byte_swap_test)
+	BOOST_AUTO_TEST_CASE(test_reverse_bytes_inplace) {
+		std::array<uint8_t, 8> data{1, 2, 3, 4, 5, 6, 7, 8};
+		reverse_bytes_inplace<4>(data.data() + 1);
+		const std::array<uint8_t, 8> expected{1, 5, 4, 3, 2, 6, 7, 8};
+		BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), data.begin(), data.end());
+	}
+
+	BOOST_AUTO_TEST_CASE_TEMPLATE(test_reverse_bytes_array_inplace, Size, byte_swap_sizes) {
+		constexpr size_t size = Size::value;
+		// Cover lengths which are not multiple of SIMD register sizes and not aligned addresses.
+		for (size_t count = 0; count < 40; ++count) {
+			std::vector<uint8_t> actual(count * size + 1);
+			for (size_t i = 0; i < actual.size(); ++i) actual[i] = static_cast<uint8_t>(i * 7 + 3);
+			auto expected = actual;
+			for (size_t i = 0; i < count; ++i) {
+				for (size_t j = 0; j < size; ++j) {
+					expected[1 + i * size + j] = actual[1 + i * size + size - 1 - j];
+				}
+			}
+
+			reverse_bytes_array_inplace<size>(actual.data() + 1, count);
+			BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), actual.begin(), actual.end());
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_deserialize_large_float_array) {
+		std::array<float, 1000> expected{};
+		for (size_t i = 0; i < expected.size(); ++i) expected[i] = static_cast<float>(i) * 0.5f - 100.0f;
+		const auto data = serialize(expected);
+		BOOST_CHECK_EQUAL(0xc2, data[0]);
+		BOOST_CHECK_EQUAL(0xc8, data[1]);
+		std::array<float, 1000> actual{};
+		deserialize(actual, data);
+		BOOST_TEST(expected == actual, boost::test_tools::per_element());
+	}
+BOOST_AUTO_TEST_SUITE_END()
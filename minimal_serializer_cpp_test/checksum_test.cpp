@@ -0,0 +1,154 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/mpl/list.hpp>
+
+#include "minimal_serializer/checksum.hpp"
+#include "serialize_test_types.hpp"
+
+using namespace std;
+using namespace minimal_serializer;
+
+namespace {
+	std::vector<uint8_t> get_random_bytes(const size_t size) {
+		std::mt19937 engine(12345);
+		std::uniform_int_distribution<int> distribution(0, 255);
+		std::vector<uint8_t> data(size);
+		for (auto& value : data) {
+			value = static_cast<uint8_t>(distribution(engine));
+		}
+		return data;
+	}
+}
+
+BOOST_AUTO_TEST_SUITE(checksum_test)
+	BOOST_AUTO_TEST_CASE(test_crc32c_known_values) {
+		const std::string text = "123456789";
+		BOOST_CHECK_EQUAL(crc32c(reinterpret_cast<const uint8_t*>(text.data()), text.size()), 0xe3069283u);
+		const std::vector<uint8_t> zeros(32, 0);
+		BOOST_CHECK_EQUAL(crc32c(zeros.data(), zeros.size()), 0x8a9136aau);
+		const std::vector<uint8_t> ones(32, 0xff);
+		BOOST_CHECK_EQUAL(crc32c(ones.data(), ones.size()), 0x62a8ab43u);
+		BOOST_CHECK_EQUAL(crc32c(nullptr, 0), 0u);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_crc32c_implementations) {
+		// Cover the three stream kernel, the 8 bytes loop and the 1 byte loop with unaligned positions.
+		const auto data = get_random_bytes(4000);
+		for (size_t offset = 0; offset < 8; ++offset) {
+			for (const size_t size : {size_t{0}, size_t{1}, size_t{7}, size_t{8}, size_t{100}, size_t{767}, size_t{768},
+									size_t{769}, size_t{1600}, size_t{3900}}) {
+				const auto expected = ~crc32c_update_software<false>(~uint32_t{0}, data.data() + offset, size, nullptr);
+				BOOST_CHECK_EQUAL(crc32c(data.data() + offset, size), expected);
+
+				std::vector<uint8_t> copied(size);
+				BOOST_CHECK_EQUAL(copy_with_crc32c(copied.data(), data.data() + offset, size), expected);
+				BOOST_CHECK_EQUAL_COLLECTIONS(copied.begin(), copied.end(), data.begin() + offset, data.begin() + offset + size);
+				BOOST_CHECK_EQUAL(~crc32c_update_software<true>(~uint32_t{0}, data.data() + offset, size, copied.data()), expected);
+			}
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(test_crc32c_continue) {
+		const auto data = get_random_bytes(2000);
+		const auto expected = crc32c(data.data(), data.size());
+		for (const size_t split : {size_t{0}, size_t{3}, size_t{1000}, size_t{2000}}) {
+			BOOST_CHECK_EQUAL(crc32c(data.data() + split, data.size() - split, crc32c(data.data(), split)), expected);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE_TEMPLATE(test_serialize_checksummed, Test, test_serializable_non_string_types) {
+		const auto expected = get_default<Test>();
+		const auto data = serialize_checksummed(expected);
+		const auto serialized = serialize(expected);
+		BOOST_CHECK_EQUAL_COLLECTIONS(data.begin(), data.end() - checksum_size, serialized.begin(), serialized.end());
+		BOOST_CHECK(is_checksum_valid<Test>(data));
+
+		Test actual{};
+		deserialize_checksummed(actual, data);
+		BOOST_CHECK(expected == actual);
+	}
+
+	BOOST_AUTO_TEST_CASE_TEMPLATE(test_serialize_checksummed_native, Test, test_serializable_non_string_types) {
+		// Layout compatible types are copied with the checksum in one pass, and the result is same as other types.
+		const auto expected = get_default<Test>();
+		const auto data = serialize_checksummed<byte_order::native>(expected);
+		const auto serialized = serialize<byte_order::native>(expected);
+		uint32_t crc;
+		std::memcpy(&crc, data.data() + serialized.size(), sizeof(crc));
+		BOOST_CHECK_EQUAL(crc, crc32c(serialized.data(), serialized.size()));
+
+		Test actual{};
+		deserialize_checksummed<byte_order::native>(actual, data);
+		BOOST_CHECK(expected == actual);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_checksummed_chunks_and_strings) {
+		// Arrays are checksummed chunk by chunk, and strings are checksummed after they are written.
+		auto large = std::make_unique<std::tuple<std::array<uint16_t, 2000>, boost_static_string_t<5>, std::array<uint64_t, 1000>>>();
+		for (size_t i = 0; i < 2000; ++i) {
+			std::get<0>(*large)[i] = static_cast<uint16_t>(i * 7);
+		}
+		std::get<1>(*large) = boost_static_string_t<5>(u8"abc");
+		for (size_t i = 0; i < 1000; ++i) {
+			std::get<2>(*large)[i] = i * 0x0123456789;
+		}
+		using large_t = std::remove_reference_t<decltype(*large)>;
+		std::vector<uint8_t> data(checksummed_serialized_size_v<large_t>);
+		serialize_checksummed(*large, data);
+		std::vector<uint8_t> serialized(serialized_size_v<large_t>);
+		serialize(*large, serialized, 0);
+		BOOST_CHECK_EQUAL_COLLECTIONS(data.begin(), data.end() - checksum_size, serialized.begin(), serialized.end());
+		uint32_t crc;
+		deserialize(crc, data, serialized.size());
+		BOOST_CHECK_EQUAL(crc, crc32c(serialized.data(), serialized.size()));
+	}
+
+	BOOST_AUTO_TEST_CASE(test_detect_corruption) {
+		const auto expected = nested_struct::get_default();
+		const auto data = serialize_checksummed(expected);
+		for (size_t i = 0; i < data.size(); ++i) {
+			for (const uint8_t bit : {uint8_t{0x01}, uint8_t{0x80}}) {
+				auto corrupted = data;
+				corrupted[i] ^= bit;
+				BOOST_CHECK(!is_checksum_valid<nested_struct>(corrupted));
+				auto actual = nested_struct::get_default();
+				actual.value1 = 0;
+				const auto before = actual;
+				BOOST_CHECK_THROW(deserialize_checksummed(actual, corrupted), serialization_error);
+				BOOST_CHECK(actual == before);
+			}
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_checksummed_buffer_and_sink) {
+		const auto expected = dense_struct::get_default();
+		constexpr auto size = checksummed_serialized_size_v<dense_struct, byte_order::little>;
+		std::vector<uint8_t> buffer(size + 2);
+		serialize_checksummed<byte_order::little>(expected, buffer, 2);
+		BOOST_CHECK_THROW(serialize_checksummed<byte_order::little>(expected, buffer, 3), serialization_error);
+
+		std::vector<uint8_t> output{0, 0};
+		container_sink sink(output);
+		serialize_checksummed<byte_order::little>(expected, sink);
+		BOOST_CHECK_EQUAL_COLLECTIONS(output.begin(), output.end(), buffer.begin(), buffer.end());
+
+		dense_struct actual{};
+		deserialize_checksummed<byte_order::little>(actual, output, 2);
+		BOOST_CHECK(expected == actual);
+		BOOST_CHECK_THROW(deserialize_checksummed<byte_order::little>(actual, output, 3), serialization_error);
+	}
+BOOST_AUTO_TEST_SUITE_END()
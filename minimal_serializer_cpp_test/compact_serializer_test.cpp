@@ -0,0 +1,188 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <array>
+#include <limits>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/mpl/list.hpp>
+
+#include "minimal_serializer/compact_serializer.hpp"
+#include "serialize_test_types.hpp"
+
+using namespace std;
+using namespace minimal_serializer;
+
+namespace {
+	using varint_types = boost::mpl::list<int16_t, uint16_t, int32_t, uint32_t, int64_t, uint64_t>;
+	using group_varint_types = boost::mpl::list<uint32_t, int32_t>;
+
+	struct sparse_record final {
+		uint32_t id;
+		int64_t delta;
+		std::array<int32_t, 6> samples;
+		std::array<uint8_t, 3> flags;
+		double value;
+
+		bool operator==(const sparse_record& other) const {
+			return id == other.id && delta == other.delta && samples == other.samples && flags == other.flags && value ==
+				other.value;
+		}
+
+		using serialize_targets = serialize_target_container<&sparse_record::id, &sparse_record::delta,
+															&sparse_record::samples, &sparse_record::flags,
+															&sparse_record::value>;
+	};
+
+	sparse_record get_sparse_record() {
+		return {3, -2, {0, 1, -1, 300, -70000, std::numeric_limits<int32_t>::min()}, {1, 2, 3}, 0.5};
+	}
+
+	// Values whose group varint sizes are 1 to 4 bytes.
+	template <typename T>
+	std::vector<T> make_group_varint_values(const size_t count) {
+		std::mt19937 engine(count);
+		std::vector<T> values(count);
+		for (auto& value : values) {
+			const auto bits = std::uniform_int_distribution<uint32_t>(0, 31)(engine);
+			value = static_cast<T>(engine() >> bits);
+		}
+		return values;
+	}
+}
+
+static_assert(compact_serialized_max_size_v<uint8_t> == 1);
+static_assert(compact_serialized_max_size_v<uint16_t> == 3);
+static_assert(compact_serialized_max_size_v<int32_t> == 5);
+static_assert(compact_serialized_max_size_v<uint64_t> == 10);
+static_assert(compact_serialized_max_size_v<double> == 8);
+static_assert(compact_serialized_max_size_v<std::array<uint32_t, 5>> == 22);
+static_assert(compact_serialized_max_size_v<sparse_record> == 5 + 10 + 26 + 3 + 8);
+static_assert(encode_zigzag(int32_t{0}) == 0 && encode_zigzag(int32_t{-1}) == 1 && encode_zigzag(int32_t{1}) == 2);
+static_assert(encode_zigzag(std::numeric_limits<int64_t>::min()) == std::numeric_limits<uint64_t>::max());
+
+BOOST_AUTO_TEST_SUITE(compact_serializer_test)
+	BOOST_AUTO_TEST_CASE_TEMPLATE(test_serialize_deserialize, Test, test_serializable_non_string_types) {
+		const auto expected = get_default<Test>();
+		const auto [data, size] = serialize_compact(expected);
+		BOOST_CHECK_EQUAL(size, compact_serialized_size(expected));
+		BOOST_CHECK_LE(size, compact_serialized_max_size_v<Test>);
+
+		Test actual{};
+		BOOST_CHECK_EQUAL(deserialize_compact(actual, data), size);
+		BOOST_CHECK(expected == actual);
+	}
+
+	BOOST_AUTO_TEST_CASE_TEMPLATE(test_serialize_deserialize_limits, Test, varint_types) {
+		for (const auto expected : {std::numeric_limits<Test>::min(), std::numeric_limits<Test>::max(), Test{0}, Test{1},
+									static_cast<Test>(127), static_cast<Test>(128)}) {
+			std::vector<uint8_t> buffer(compact_serialized_max_size_v<Test>);
+			const auto size = serialize_compact(expected, buffer);
+			Test actual{};
+			BOOST_CHECK_EQUAL(deserialize_compact(actual, buffer), size);
+			BOOST_CHECK_EQUAL(expected, actual);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_varint) {
+		const auto [data, size] = serialize_compact(std::make_tuple(uint32_t{300}, int32_t{-65}, uint16_t{5}));
+		const std::vector<uint8_t> expected{0xac, 0x02, 0x81, 0x01, 0x05};
+		BOOST_CHECK_EQUAL_COLLECTIONS(data.begin(), data.begin() + size, expected.begin(), expected.end());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_deserialize_custom_type) {
+		const auto expected = get_sparse_record();
+		std::vector<uint8_t> buffer(100);
+		const auto size = serialize_compact(expected, buffer, 1);
+		BOOST_CHECK_EQUAL(size, compact_serialized_size(expected));
+		BOOST_CHECK_LT(size, serialized_size_v<sparse_record>);
+
+		sparse_record actual{};
+		BOOST_CHECK_EQUAL(deserialize_compact(actual, buffer, 1), size);
+		BOOST_CHECK(expected == actual);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_deserialize_string) {
+		using tuple_type = std::tuple<boost_static_string_t<16>, uint16_t>;
+		const tuple_type expected{reinterpret_cast<const boost_static_string_t<16>::value_type*>("abc"), 1};
+		const auto [data, size] = serialize_compact(expected);
+		const std::vector<uint8_t> expected_data{3, 'a', 'b', 'c', 1};
+		BOOST_CHECK_EQUAL_COLLECTIONS(data.begin(), data.begin() + size, expected_data.begin(), expected_data.end());
+
+		tuple_type actual{};
+		BOOST_CHECK_EQUAL(deserialize_compact(actual, data), size);
+		BOOST_CHECK(expected == actual);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_sink) {
+		const auto expected = get_sparse_record();
+		std::vector<uint8_t> buffer;
+		container_sink sink(buffer);
+		const auto size = serialize_compact(expected, sink);
+		BOOST_CHECK_EQUAL(buffer.size(), size);
+
+		// A fixed buffer smaller than the maximum size is available if the actual size fits.
+		std::vector<uint8_t> small_buffer(size);
+		buffer_sink small_sink(small_buffer);
+		BOOST_CHECK_EQUAL(serialize_compact(expected, small_sink), size);
+		BOOST_CHECK(buffer == small_buffer);
+		BOOST_CHECK_THROW(serialize_compact(expected, small_sink), serialization_error);
+	}
+
+	BOOST_AUTO_TEST_CASE_TEMPLATE(test_group_varint, Test, group_varint_types) {
+		for (const size_t count : {0, 1, 3, 4, 5, 8, 17, 100}) {
+			const auto expected = make_group_varint_values<Test>(count);
+			std::vector<uint8_t> buffer(get_group_varint_max_size(count));
+			const auto end = write_group_varint(expected.data(), count, buffer.data());
+			BOOST_CHECK_EQUAL(static_cast<size_t>(end - buffer.data()), get_group_varint_size(expected.data(), count));
+
+			// Decode from exact size data to test the end of data.
+			const std::vector<uint8_t> data(buffer.data(), end);
+			std::vector<Test> actual(count);
+			BOOST_CHECK(read_group_varint(actual.data(), count, data.data(), data.data() + data.size()) == data.data() +
+				data.size());
+			BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+			if (!data.empty()) {
+				BOOST_CHECK_THROW(read_group_varint(actual.data(), count, data.data(), data.data() + data.size() - 1),
+								serialization_error);
+			}
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(test_deserialize_malformed) {
+		uint16_t value16;
+		BOOST_CHECK_THROW(deserialize_compact(value16, std::vector<uint8_t>{0xff, 0xff, 0x04}), serialization_error);
+		BOOST_CHECK_NO_THROW(deserialize_compact(value16, std::vector<uint8_t>{0xff, 0xff, 0x03}));
+		BOOST_CHECK_EQUAL(value16, 0xffff);
+		uint64_t value64;
+		BOOST_CHECK_THROW(deserialize_compact(value64, std::vector<uint8_t>(11, 0x80)), serialization_error);
+		BOOST_CHECK_THROW(deserialize_compact(value64, std::vector<uint8_t>{0x80}), serialization_error);
+
+		boost_static_string_t<4> text;
+		BOOST_CHECK_THROW(deserialize_compact(text, std::vector<uint8_t>{5, 'a', 'b', 'c', 'd', 'e'}), serialization_error);
+		BOOST_CHECK_THROW(deserialize_compact(text, std::vector<uint8_t>{3, 'a', 'b'}), serialization_error);
+		BOOST_CHECK_EQUAL(deserialize_compact(text, std::vector<uint8_t>{2, 'a', 'b'}), 3u);
+		BOOST_CHECK_EQUAL(text.size(), 2u);
+
+		double real;
+		BOOST_CHECK_THROW(deserialize_compact(real, std::vector<uint8_t>(7)), serialization_error);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_out_of_range) {
+		std::vector<uint8_t> buffer(2);
+		BOOST_CHECK_NO_THROW(serialize_compact(uint64_t{300}, buffer));
+		BOOST_CHECK_THROW(serialize_compact(uint64_t{300}, buffer, 1), serialization_error);
+		BOOST_CHECK_THROW(serialize_compact(uint64_t{300}, buffer, 3), serialization_error);
+	}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,194 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/mpl/list.hpp>
+
+#include "minimal_serializer/delta_codec.hpp"
+#include "serialize_test_types.hpp"
+
+using namespace std;
+using namespace minimal_serializer;
+
+namespace {
+	template <typename T, byte_order Order = byte_order::big>
+	std::vector<uint8_t> encode_all(const std::vector<T>& records, const delta_encoder_options& options, std::vector<size_t>& frame_sizes) {
+		delta_encoder<T, Order> encoder(options);
+		std::vector<uint8_t> data;
+		container_sink sink(data);
+		for (const auto& record : records) {
+			frame_sizes.push_back(encoder.encode(record, sink));
+		}
+		return data;
+	}
+
+	template <typename T, byte_order Order = byte_order::big>
+	std::vector<T> decode_all(const std::vector<uint8_t>& data) {
+		delta_decoder<T, Order> decoder;
+		std::vector<T> records;
+		for (size_t offset = 0; offset < data.size();) {
+			T record{};
+			offset += decoder.decode(record, data, offset);
+			records.push_back(record);
+		}
+		return records;
+	}
+
+	std::vector<dense_struct> get_counter_records() {
+		std::vector<dense_struct> records;
+		auto record = dense_struct::get_default();
+		for (int i = 0; i < 300; ++i) {
+			record.value1 += 1000;
+			record.value2 = static_cast<uint16_t>(record.value2 + 300);
+			record.value5[1] = static_cast<int16_t>(i);
+			records.push_back(record);
+		}
+		return records;
+	}
+}
+
+BOOST_AUTO_TEST_SUITE(delta_codec_test)
+	BOOST_AUTO_TEST_CASE_TEMPLATE(test_encode_decode_same_records, Test, test_serializable_non_string_types) {
+		const std::vector<Test> records(5, get_default<Test>());
+		for (const auto method : {delta_method::xor_bytes, delta_method::subtract}) {
+			std::vector<size_t> frame_sizes;
+			const auto data = encode_all(records, {method, 64}, frame_sizes);
+			BOOST_CHECK_EQUAL(frame_sizes[0], (delta_encoder<Test>::max_frame_size));
+			for (const auto frame_size : frame_sizes) {
+				BOOST_CHECK_LE(frame_size, (delta_encoder<Test>::max_frame_size));
+			}
+			const auto actual = decode_all<Test>(data);
+			BOOST_CHECK(actual == records);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(test_encode_decode_changing_records) {
+		const auto records = get_counter_records();
+		for (const auto method : {delta_method::xor_bytes, delta_method::subtract}) {
+			std::vector<size_t> frame_sizes;
+			const auto data = encode_all(records, {method, 64}, frame_sizes);
+			BOOST_CHECK_LT(data.size(), records.size() * serialized_size_v<dense_struct>);
+			const auto actual = decode_all<dense_struct>(data);
+			BOOST_CHECK(actual == records);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(test_subtract_delta_of_counters) {
+		const auto records = get_counter_records();
+		std::vector<size_t> xor_sizes;
+		std::vector<size_t> subtract_sizes;
+		const auto xor_data = encode_all(records, {delta_method::xor_bytes, 0}, xor_sizes);
+		const auto subtract_data = encode_all(records, {delta_method::subtract, 0}, subtract_sizes);
+		BOOST_CHECK_LT(subtract_data.size(), xor_data.size());
+
+		// The delta is same in all records: 00 00 03 e8 | 01 2c | 00 | 00 | 00 00 00 01 | 00 00 00 00
+		// It is encoded as 3 runs: (2 zeros, 4 literals), (5 zeros, 1 literal) and (4 zeros, no literal).
+		BOOST_CHECK_EQUAL(subtract_sizes[0], 1 + serialized_size_v<dense_struct>);
+		for (size_t i = 1; i < subtract_sizes.size(); ++i) {
+			BOOST_CHECK_EQUAL(subtract_sizes[i], 1 + (2 + 4) + (2 + 1) + 2);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(test_encode_decode_little_endian) {
+		const auto records = get_counter_records();
+		std::vector<size_t> frame_sizes;
+		const auto data = encode_all<dense_struct, byte_order::little>(records, {delta_method::subtract, 16}, frame_sizes);
+		const auto actual = decode_all<dense_struct, byte_order::little>(data);
+		BOOST_CHECK(actual == records);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_keyframe_interval) {
+		const std::vector<uint64_t> records{1, 2, 3, 4, 5, 6, 7};
+		std::vector<size_t> frame_sizes;
+		const auto data = encode_all(records, {delta_method::xor_bytes, 3}, frame_sizes);
+		const std::vector<size_t> expected_sizes{9, 4, 4, 9, 4, 4, 9};
+		BOOST_CHECK_EQUAL_COLLECTIONS(frame_sizes.begin(), frame_sizes.end(), expected_sizes.begin(), expected_sizes.end());
+		BOOST_CHECK_EQUAL(data[0], static_cast<uint8_t>(delta_frame_type::keyframe));
+		BOOST_CHECK_EQUAL(data[9], static_cast<uint8_t>(delta_frame_type::xor_delta));
+		BOOST_CHECK_EQUAL(data[17], static_cast<uint8_t>(delta_frame_type::keyframe));
+
+		// A decoder can start from any keyframe.
+		const std::vector<uint8_t> tail(data.begin() + 17, data.end());
+		const auto actual = decode_all<uint64_t>(tail);
+		const std::vector<uint64_t> expected(records.begin() + 3, records.end());
+		BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_reset) {
+		delta_encoder<uint64_t> encoder;
+		std::array<uint8_t, delta_encoder<uint64_t>::max_frame_size> data{};
+		BOOST_CHECK_EQUAL(encoder.encode(1, data), 9u);
+		BOOST_CHECK_EQUAL(encoder.encode(1, data), 3u);
+		encoder.reset();
+		BOOST_CHECK_EQUAL(encoder.encode(1, data), 9u);
+
+		delta_decoder<uint64_t> decoder;
+		uint64_t actual = 0;
+		const std::vector<uint8_t> delta_frame{1, 8, 0};
+		BOOST_CHECK_THROW(decoder.decode(actual, delta_frame), serialization_error);
+		BOOST_CHECK_EQUAL(decoder.decode(actual, data), 9u);
+		BOOST_CHECK_EQUAL(decoder.decode(actual, delta_frame), 3u);
+		BOOST_CHECK_EQUAL(actual, 1u);
+		decoder.reset();
+		BOOST_CHECK_THROW(decoder.decode(actual, delta_frame), serialization_error);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_encode_out_of_range) {
+		delta_encoder<uint64_t> encoder;
+		std::array<uint8_t, delta_encoder<uint64_t>::max_frame_size> data{};
+		BOOST_CHECK_THROW(encoder.encode(1, data, 1), serialization_error);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_decode_malformed_frames) {
+		const std::vector<uint8_t> keyframe{0, 0, 0, 0, 0, 0, 0, 0, 1};
+		const std::vector<std::vector<uint8_t>> frames{
+			// Empty
+			{},
+			// Unknown frame type
+			{3, 8, 0},
+			// Truncated keyframe
+			{0, 0, 0, 0, 0, 0, 0, 0},
+			// Zero run exceeds the record
+			{1, 9, 0},
+			// Literal run exceeds the record
+			{1, 7, 2, 1, 1},
+			// Runs do not make progress
+			{1, 0, 0},
+			// Truncated literal
+			{1, 7, 1},
+			// Truncated varint
+			{2, 0x80},
+		};
+		for (const auto& frame : frames) {
+			delta_decoder<uint64_t> decoder;
+			uint64_t actual;
+			decoder.decode(actual, keyframe);
+			BOOST_CHECK_THROW(decoder.decode(actual, frame), serialization_error);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(test_decode_after_malformed_frame) {
+		const std::vector<uint8_t> keyframe{0, 0, 0, 0, 0, 0, 0, 0, 1};
+		// The first run (no zeros, 1 literal) is valid but the second literal run is truncated.
+		const std::vector<uint8_t> truncated_frame{1, 0, 1, 0xff, 0, 5};
+		// Flip the lowest 2 bits.
+		const std::vector<uint8_t> delta_frame{1, 7, 1, 3};
+		delta_decoder<uint64_t> decoder;
+		uint64_t actual;
+		decoder.decode(actual, keyframe);
+		BOOST_CHECK_THROW(decoder.decode(actual, truncated_frame), serialization_error);
+
+		// The previous record is not changed by the malformed frame.
+		BOOST_CHECK_EQUAL(decoder.decode(actual, delta_frame), 4u);
+		BOOST_CHECK_EQUAL(actual, 2u);
+	}
+BOOST_AUTO_TEST_SUITE_END()
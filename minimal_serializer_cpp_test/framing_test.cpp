@@ -0,0 +1,114 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <array>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "minimal_serializer/framing.hpp"
+#include "serialize_test_types.hpp"
+
+using namespace std;
+using namespace minimal_serializer;
+
+namespace {
+	using message_list = std::tuple<simple_struct_member_serialize, nested_struct, dense_struct, uint32_t>;
+
+	// A message list which needs two bytes for IDs.
+	template <size_t I>
+	using indexed_message = std::array<uint8_t, I + 1>;
+
+	template <size_t... Is>
+	auto make_large_message_list(std::index_sequence<Is...>) -> std::tuple<indexed_message<Is>...>;
+
+	using large_message_list = decltype(make_large_message_list(std::make_index_sequence<300>{}));
+
+	// A visitor which records the ID of the last dispatched message.
+	struct id_visitor final {
+		size_t id = SIZE_MAX;
+		nested_struct nested{};
+
+		template <typename Message>
+		void operator()(const Message& message) {
+			id = framed_message_id_v<message_list, Message>;
+			if constexpr (std::is_same_v<Message, nested_struct>) {
+				nested = message;
+			}
+		}
+	};
+}
+
+static_assert(framed_message_id_v<message_list, simple_struct_member_serialize> == 0);
+static_assert(framed_message_id_v<message_list, const dense_struct&> == 2);
+static_assert(framed_message_id_v<message_list, uint32_t> == 3);
+static_assert(frame_header_size_v<message_list> == 1);
+static_assert(frame_header_size_v<large_message_list> == 2);
+static_assert(framed_size_v<message_list, uint32_t> == 5);
+
+BOOST_AUTO_TEST_SUITE(framing_test)
+	BOOST_AUTO_TEST_CASE(test_encode_framed) {
+		const auto data = encode_framed<message_list>(uint32_t{0x01020304});
+		const std::array<uint8_t, 5> expected{3, 1, 2, 3, 4};
+		BOOST_CHECK_EQUAL_COLLECTIONS(data.begin(), data.end(), expected.begin(), expected.end());
+
+		const auto little_data = encode_framed<message_list, byte_order::little>(uint32_t{0x01020304});
+		const std::array<uint8_t, 5> little_expected{3, 4, 3, 2, 1};
+		BOOST_CHECK_EQUAL_COLLECTIONS(little_data.begin(), little_data.end(), little_expected.begin(),
+									little_expected.end());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_encode_dispatch) {
+		const auto expected = nested_struct::get_default();
+		std::vector<uint8_t> buffer(128);
+		auto size = encode_framed<message_list>(uint32_t{1}, buffer);
+		size += encode_framed<message_list>(expected, buffer, size);
+		BOOST_CHECK_EQUAL(size, (framed_size_v<message_list, uint32_t> + framed_size_v<message_list, nested_struct>));
+
+		id_visitor visitor;
+		auto offset = dispatch<message_list>(buffer, visitor);
+		BOOST_CHECK_EQUAL(visitor.id, 3u);
+		offset += dispatch<message_list>(buffer, visitor, offset);
+		BOOST_CHECK_EQUAL(visitor.id, 1u);
+		BOOST_CHECK(visitor.nested == expected);
+		BOOST_CHECK_EQUAL(offset, size);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_encode_dispatch_large_list) {
+		std::vector<uint8_t> buffer(framed_size_v<large_message_list, indexed_message<299>, byte_order::little>);
+		indexed_message<299> expected{};
+		expected.back() = 0xab;
+		encode_framed<large_message_list, byte_order::little>(expected, buffer);
+		BOOST_CHECK_EQUAL(buffer[0], 299 & 0xff);
+		BOOST_CHECK_EQUAL(buffer[1], 299 >> 8);
+
+		size_t actual_size = 0;
+		const auto size = dispatch<large_message_list, byte_order::little>(buffer, [&](const auto& message) {
+			actual_size = message.size();
+			BOOST_CHECK_EQUAL(message.back(), 0xab);
+		});
+		BOOST_CHECK_EQUAL(actual_size, 300u);
+		BOOST_CHECK_EQUAL(size, buffer.size());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_dispatch_error) {
+		const auto ignore = [](const auto&) {};
+		BOOST_CHECK_THROW(dispatch<message_list>(std::vector<uint8_t>{}, ignore), serialization_error);
+		BOOST_CHECK_THROW(dispatch<message_list>(std::vector<uint8_t>{4, 0, 0, 0, 0}, ignore), serialization_error);
+		BOOST_CHECK_THROW(dispatch<message_list>(std::vector<uint8_t>{3, 0, 0, 0}, ignore), serialization_error);
+		BOOST_CHECK_NO_THROW(dispatch<message_list>(std::vector<uint8_t>{3, 0, 0, 0, 0}, ignore));
+
+		std::array<uint8_t, 4> buffer{};
+		BOOST_CHECK_THROW(encode_framed<message_list>(uint32_t{0}, buffer), serialization_error);
+	}
+BOOST_AUTO_TEST_SUITE_END()
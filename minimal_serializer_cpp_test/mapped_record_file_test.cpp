@@ -0,0 +1,163 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <array>
+#include <vector>
+#include "minimal_serializer/mapped_record_file.hpp"
+
+#ifdef MINIMAL_SERIALIZER_POSIX_IO
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "serialize_test_types.hpp"
+
+using namespace std;
+using namespace minimal_serializer;
+
+namespace {
+	// A path of a temporary file which is removed automatically.
+	class temporary_path final {
+	public:
+		temporary_path() {
+			char path[] = "/tmp/mapped_record_file_test_XXXXXX";
+			const auto fd = mkstemp(path);
+			BOOST_REQUIRE(fd >= 0);
+			close(fd);
+			path_ = path;
+		}
+
+		temporary_path(const temporary_path&) = delete;
+		~temporary_path() { std::remove(path_.c_str()); }
+		temporary_path& operator=(const temporary_path&) = delete;
+
+		[[nodiscard]] const char* c_str() const { return path_.c_str(); }
+
+	private:
+		std::string path_;
+	};
+
+	std::vector<dense_struct> make_records(const size_t count) {
+		std::vector<dense_struct> records(count, dense_struct::get_default());
+		for (size_t i = 0; i < count; ++i) {
+			records[i].value1 = static_cast<int32_t>(i);
+		}
+		return records;
+	}
+}
+
+BOOST_AUTO_TEST_SUITE(mapped_record_file_test)
+	BOOST_AUTO_TEST_CASE(test_append_and_read) {
+		const temporary_path path;
+		const auto records = make_records(1000);
+		{
+			mapped_record_file<dense_struct> file(path.c_str(), mapped_file_mode::read_write, 8);
+			BOOST_CHECK(file.empty());
+			file.header_data()[0] = 42;
+			for (size_t i = 0; i < 100; ++i) {
+				file.push_back(records[i]);
+			}
+			file.append_range(std::vector<dense_struct>(records.begin() + 100, records.end()));
+			BOOST_CHECK_EQUAL(records.size(), file.size());
+			file.sync();
+		}
+
+		// Extra space is truncated on destruction.
+		FILE* raw = std::fopen(path.c_str(), "rb");
+		std::fseek(raw, 0, SEEK_END);
+		BOOST_CHECK_EQUAL(8 + records.size() * serialized_size_v<dense_struct>, static_cast<size_t>(std::ftell(raw)));
+		std::fclose(raw);
+
+		const mapped_record_file<dense_struct> file(path.c_str(), mapped_file_mode::read_only, 8);
+		BOOST_CHECK_EQUAL(42, file.header_data()[0]);
+		BOOST_REQUIRE_EQUAL(records.size(), file.size());
+		BOOST_CHECK(records[500] == file[500]);
+		BOOST_CHECK(records[999] == file.at(999));
+		BOOST_CHECK_THROW((void)file.at(1000), std::out_of_range);
+		BOOST_CHECK(std::equal(records.begin(), records.end(), file.begin(), file.end()));
+		BOOST_CHECK_EQUAL(777, file.view(777).get<&dense_struct::value1>());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialized_data_layout) {
+		const temporary_path path;
+		const auto records = make_records(10);
+		{
+			mapped_record_file<dense_struct, byte_order::little> file(path.c_str(), mapped_file_mode::read_write);
+			file.append_range(records);
+		}
+
+		std::vector<uint8_t> expected(records.size() * serialized_size_v<dense_struct>);
+		serialize_range<byte_order::little>(records, expected);
+		std::vector<uint8_t> actual(expected.size() + 1);
+		FILE* raw = std::fopen(path.c_str(), "rb");
+		actual.resize(std::fread(actual.data(), 1, actual.size(), raw));
+		std::fclose(raw);
+		BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), actual.begin(), actual.end());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_set_and_advise) {
+		const temporary_path path;
+		mapped_record_file<dense_struct> file(path.c_str(), mapped_file_mode::read_write);
+		file.advise(access_pattern::random);
+		file.append_range(make_records(100));
+		auto record = dense_struct::get_default();
+		record.value2 = 1;
+		file.set(50, record);
+		BOOST_CHECK(record == file[50]);
+		BOOST_CHECK_THROW(file.set(100, record), std::out_of_range);
+		file.advise(access_pattern::sequential);
+
+		const auto it = file.begin() + 50;
+		BOOST_CHECK_EQUAL(100, file.end() - file.begin());
+		BOOST_CHECK(record == *it);
+		BOOST_CHECK(record == file.begin()[50]);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_failed_reserve) {
+		const temporary_path path;
+		const auto records = make_records(100);
+		{
+			mapped_record_file<dense_struct> file(path.c_str(), mapped_file_mode::read_write);
+			file.append_range(records);
+			// Extending or mapping the file fails because the size is too large.
+			const auto huge_capacity = static_cast<size_t>(std::numeric_limits<off_t>::max()) / serialized_size_v<dense_struct>;
+			BOOST_CHECK_THROW(file.reserve(huge_capacity), std::system_error);
+
+			// The file is still usable after the failure.
+			file.append_range(records);
+			BOOST_REQUIRE_EQUAL(200, file.size());
+			BOOST_CHECK(records[99] == file[99]);
+			BOOST_CHECK(records[99] == file[199]);
+		}
+
+		FILE* raw = std::fopen(path.c_str(), "rb");
+		std::fseek(raw, 0, SEEK_END);
+		const auto file_size = std::ftell(raw);
+		std::fclose(raw);
+		BOOST_CHECK_EQUAL(200 * serialized_size_v<dense_struct>, static_cast<size_t>(file_size));
+	}
+
+	BOOST_AUTO_TEST_CASE(test_read_only) {
+		const temporary_path path;
+		mapped_record_file<dense_struct> file(path.c_str());
+		BOOST_CHECK(file.empty());
+		BOOST_CHECK(file.begin() == file.end());
+		BOOST_CHECK_THROW(file.push_back(dense_struct::get_default()), serialization_error);
+		BOOST_CHECK_THROW(mapped_record_file<dense_struct>(path.c_str(), mapped_file_mode::read_only, 4),
+						serialization_error);
+		BOOST_CHECK_THROW(mapped_record_file<dense_struct>("/nonexistent/file"), std::system_error);
+	}
+BOOST_AUTO_TEST_SUITE_END()
+#endif
@@ -0,0 +1,137 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "minimal_serializer/mpmc_record_queue.hpp"
+#include "serialize_test_types.hpp"
+
+using namespace std;
+using namespace minimal_serializer;
+
+BOOST_AUTO_TEST_SUITE(mpmc_record_queue_test)
+	BOOST_AUTO_TEST_CASE(test_full_and_empty) {
+		mpmc_record_queue<dense_struct> queue(3);
+		BOOST_CHECK_EQUAL(4, queue.capacity());
+		dense_struct actual{};
+		BOOST_CHECK(!queue.try_pop(actual));
+		for (int32_t i = 0; i < 4; ++i) {
+			auto record = dense_struct::get_default();
+			record.value1 = i;
+			BOOST_CHECK(queue.try_push(record));
+		}
+		BOOST_CHECK(!queue.try_push(dense_struct::get_default()));
+		for (int32_t i = 0; i < 4; ++i) {
+			BOOST_CHECK(queue.try_pop(actual));
+			BOOST_CHECK_EQUAL(i, actual.value1);
+		}
+		BOOST_CHECK(!queue.try_pop(actual));
+	}
+
+	BOOST_AUTO_TEST_CASE(test_batch_wrap_around) {
+		mpmc_record_queue<nested_struct, byte_order::little> queue(8);
+		std::vector<nested_struct> records(10, nested_struct::get_default());
+		for (size_t i = 0; i < records.size(); ++i) {
+			records[i].value2 = static_cast<int64_t>(i);
+		}
+
+		// Move positions to the middle of slots so that batches wrap around.
+		BOOST_CHECK_EQUAL(5, queue.try_push_batch(std::vector<nested_struct>(records.begin(), records.begin() + 5)));
+		std::vector<nested_struct> actual(10);
+		BOOST_CHECK_EQUAL(5, queue.try_pop_batch(actual));
+
+		// Only free slots are claimed.
+		BOOST_CHECK_EQUAL(8, queue.try_push_batch(records));
+		BOOST_CHECK_EQUAL(0, queue.try_push_batch(records));
+		BOOST_CHECK_EQUAL(8, queue.try_pop_batch(actual));
+		BOOST_CHECK(std::equal(records.begin(), records.begin() + 8, actual.begin()));
+		BOOST_CHECK_EQUAL(0, queue.try_pop_batch(actual));
+	}
+
+	BOOST_AUTO_TEST_CASE(test_empty_batch) {
+		// Records are copied by memcpy, and data() of empty vectors may be null.
+		mpmc_record_queue<uint64_t> queue(4);
+		std::vector<uint64_t> empty;
+		BOOST_CHECK_EQUAL(0, queue.try_push_batch(empty));
+		BOOST_CHECK_EQUAL(0, queue.try_pop_batch(empty));
+
+		const std::vector<uint64_t> records{1, 2, 3};
+		BOOST_CHECK_EQUAL(3, queue.try_push_batch(records));
+		BOOST_CHECK_EQUAL(0, queue.try_pop_batch(empty));
+		std::vector<uint64_t> actual(4);
+		BOOST_CHECK_EQUAL(3, queue.try_pop_batch(actual));
+		BOOST_CHECK(std::equal(records.begin(), records.end(), actual.begin()));
+		BOOST_CHECK_EQUAL(0, queue.try_pop_batch(actual));
+	}
+
+	BOOST_AUTO_TEST_CASE(test_multiple_producers_and_consumers) {
+		constexpr int32_t thread_count = 4;
+		constexpr int32_t count_per_producer = 50000;
+		mpmc_record_queue<dense_struct> queue(64);
+		std::vector<std::atomic<int>> received(thread_count * count_per_producer);
+
+		std::vector<std::thread> threads;
+		for (int32_t t = 0; t < thread_count; ++t) {
+			threads.emplace_back([&, t] {
+				// Even producers push records one by one and odd producers push batches.
+				std::vector<dense_struct> batch;
+				auto record = dense_struct::get_default();
+				for (int32_t i = 0; i < count_per_producer; ++i) {
+					record.value1 = t * count_per_producer + i;
+					if (t % 2 == 0) {
+						while (!queue.try_push(record)) {
+							std::this_thread::yield();
+						}
+						continue;
+					}
+					batch.push_back(record);
+					if (batch.size() == 7 || i + 1 == count_per_producer) {
+						size_t pushed = 0;
+						while (pushed < batch.size()) {
+							pushed += queue.try_push_batch(
+								std::vector<dense_struct>(batch.begin() + pushed, batch.end()));
+							std::this_thread::yield();
+						}
+						batch.clear();
+					}
+				}
+			});
+		}
+
+		std::atomic<int32_t> total{0};
+		for (int32_t t = 0; t < thread_count; ++t) {
+			threads.emplace_back([&] {
+				std::vector<dense_struct> batch(5);
+				while (total.load() < thread_count * count_per_producer) {
+					const auto popped = queue.try_pop_batch(batch);
+					for (size_t i = 0; i < popped; ++i) {
+						received[batch[i].value1].fetch_add(1);
+					}
+					total.fetch_add(static_cast<int32_t>(popped));
+					if (popped == 0) {
+						std::this_thread::yield();
+					}
+				}
+			});
+		}
+
+		for (auto& thread : threads) {
+			thread.join();
+		}
+		BOOST_CHECK(std::all_of(received.begin(), received.end(), [](const std::atomic<int>& r) { return r.load() == 1; }));
+	}
+BOOST_AUTO_TEST_SUITE_END()
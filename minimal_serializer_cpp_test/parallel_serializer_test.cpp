@@ -0,0 +1,101 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <array>
+#include <vector>
+#include <tuple>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "minimal_serializer/parallel_serializer.hpp"
+#include "serialize_test_types.hpp"
+
+using namespace std;
+using namespace minimal_serializer;
+
+namespace {
+	template <typename T>
+	std::vector<T> make_objects(const size_t count) {
+		std::vector<T> objects(count);
+		for (size_t i = 0; i < count; ++i) {
+			std::get<0>(objects[i]) = static_cast<int32_t>(i * 2654435761u);
+			std::get<1>(objects[i]) = static_cast<uint16_t>(i);
+			std::get<2>(objects[i]) = static_cast<uint8_t>(i * 3);
+		}
+		return objects;
+	}
+}
+
+// A type whose serialized size is not a divisor of cache line size.
+using odd_size_tuple = std::tuple<int32_t, uint16_t, uint8_t>;
+
+BOOST_AUTO_TEST_SUITE(parallel_serializer_test)
+	BOOST_AUTO_TEST_CASE(test_parallel_chunk_plan) {
+		alignas(cache_line_size) static uint8_t buffer[cache_line_size * 4];
+		for (size_t offset = 0; offset < 8; ++offset) {
+			const size_t count = 100000;
+			const parallel_chunk_plan plan(buffer + offset, 7, count);
+			BOOST_CHECK_GT(plan.chunk_count(), 1);
+			BOOST_CHECK_EQUAL(0, plan.begin(0));
+			BOOST_CHECK_EQUAL(count, plan.end(plan.chunk_count() - 1));
+			for (size_t i = 1; i < plan.chunk_count(); ++i) {
+				BOOST_CHECK_EQUAL(plan.end(i - 1), plan.begin(i));
+				// Chunk boundaries are on cache lines.
+				BOOST_CHECK_EQUAL(0, (offset + plan.begin(i) * 7) % cache_line_size);
+			}
+		}
+		BOOST_CHECK_EQUAL(0, parallel_chunk_plan(buffer, 7, 0).chunk_count());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_range_parallel_equals_serial) {
+		const auto objects = make_objects<odd_size_tuple>(100003);
+		constexpr auto size = serialized_size_v<odd_size_tuple>;
+		std::vector<uint8_t> expected(objects.size() * size + 5);
+		serialize_range(objects, expected, 5);
+		for (const size_t thread_count : {1, 3, 8}) {
+			thread_pool pool(thread_count);
+			std::vector<uint8_t> actual(expected.size());
+			serialize_range_parallel(objects, actual, pool, 5);
+			BOOST_CHECK(expected == actual);
+
+			std::vector<odd_size_tuple> deserialized(objects.size());
+			deserialize_range_parallel(deserialized, actual, pool, 5);
+			BOOST_CHECK(objects == deserialized);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_deserialize_range_parallel_layout_compatible) {
+		std::vector<dense_struct> expected(50000);
+		for (size_t i = 0; i < expected.size(); ++i) {
+			expected[i].value1 = static_cast<int32_t>(i);
+		}
+		std::vector<uint8_t> buffer(expected.size() * serialized_size_v<dense_struct>);
+		serialize_range_parallel<byte_order::little>(expected, buffer);
+		std::vector<dense_struct> actual(expected.size());
+		deserialize_range_parallel<byte_order::little>(actual, buffer);
+		BOOST_CHECK(expected == actual);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_deserialize_range_parallel_empty) {
+		const std::vector<dense_struct> expected;
+		std::vector<uint8_t> buffer;
+		BOOST_CHECK_NO_THROW(serialize_range_parallel(expected, buffer));
+		std::vector<dense_struct> actual;
+		BOOST_CHECK_NO_THROW(deserialize_range_parallel(actual, buffer));
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_deserialize_range_parallel_out_of_range) {
+		std::vector<dense_struct> objects(1000);
+		std::vector<uint8_t> buffer(objects.size() * serialized_size_v<dense_struct>);
+		BOOST_CHECK_THROW(serialize_range_parallel(objects, buffer, 1), serialization_error);
+		BOOST_CHECK_THROW(deserialize_range_parallel(objects, buffer, 1), serialization_error);
+	}
+BOOST_AUTO_TEST_SUITE_END()
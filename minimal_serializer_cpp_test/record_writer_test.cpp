@@ -0,0 +1,133 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <array>
+#include <vector>
+#include "minimal_serializer/record_writer.hpp"
+
+#ifdef MINIMAL_SERIALIZER_POSIX_IO
+#include <cstdio>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include "serialize_test_types.hpp"
+
+using namespace std;
+using namespace minimal_serializer;
+
+namespace {
+	// A temporary file which is removed automatically.
+	class temporary_file final {
+	public:
+		temporary_file() : file_(std::tmpfile()) {}
+		temporary_file(const temporary_file&) = delete;
+		~temporary_file() { std::fclose(file_); }
+		temporary_file& operator=(const temporary_file&) = delete;
+
+		[[nodiscard]] int fd() const { return fileno(file_); }
+
+		[[nodiscard]] std::vector<uint8_t> read_all() const {
+			struct stat st{};
+			fstat(fd(), &st);
+			std::vector<uint8_t> data(static_cast<size_t>(st.st_size));
+			BOOST_REQUIRE_EQUAL(static_cast<ssize_t>(data.size()), pread(fd(), data.data(), data.size(), 0));
+			return data;
+		}
+
+	private:
+		FILE* file_;
+	};
+
+	std::vector<dense_struct> make_records(const size_t count) {
+		std::vector<dense_struct> records(count, dense_struct::get_default());
+		for (size_t i = 0; i < count; ++i) {
+			records[i].value1 = static_cast<int32_t>(i);
+		}
+		return records;
+	}
+}
+
+BOOST_AUTO_TEST_SUITE(record_writer_test)
+	BOOST_AUTO_TEST_CASE(test_write) {
+		const auto records = make_records(1000);
+		const temporary_file file;
+		{
+			record_writer<dense_struct> writer(file.fd(), {100});
+			// The capacity is rounded up to a multiple of the record size.
+			BOOST_CHECK_EQUAL(112, writer.capacity());
+			for (const auto& record : records) {
+				writer.write(record);
+			}
+		}
+
+		std::vector<uint8_t> expected(records.size() * serialized_size_v<dense_struct>);
+		serialize_range(records, expected);
+		const auto actual = file.read_all();
+		BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), actual.begin(), actual.end());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_write_range_little_endian) {
+		const auto records = make_records(1000);
+		const temporary_file file;
+		record_writer<dense_struct, byte_order::little> writer(file.fd(), {1024, 0, fsync_policy::per_batch});
+		writer.write_range(records);
+		writer.flush();
+
+		std::vector<uint8_t> expected(records.size() * serialized_size_v<dense_struct>);
+		serialize_range<byte_order::little>(records, expected);
+		const auto actual = file.read_all();
+		BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), actual.begin(), actual.end());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_flush_threshold) {
+		const temporary_file file;
+		record_writer<dense_struct> writer(file.fd(), {1024, 64, fsync_policy::interval});
+		for (size_t i = 0; i < 3; ++i) {
+			writer.write(dense_struct::get_default());
+		}
+		BOOST_CHECK_EQUAL(48, writer.buffered_size());
+		BOOST_CHECK(file.read_all().empty());
+
+		writer.write(dense_struct::get_default());
+		BOOST_CHECK_EQUAL(0, writer.buffered_size());
+		BOOST_CHECK_EQUAL(64, file.read_all().size());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_write_serialized) {
+		const auto records = make_records(100);
+		std::vector<uint8_t> expected(records.size() * serialized_size_v<dense_struct>);
+		serialize_range(records, expected);
+
+		const temporary_file file;
+		record_writer<dense_struct> writer(file.fd(), {256});
+		// Small data is staged.
+		writer.write_serialized(std::vector<uint8_t>(expected.begin(), expected.begin() + 32));
+		BOOST_CHECK_EQUAL(32, writer.buffered_size());
+		// Large data is written directly with staged data.
+		writer.write_serialized(std::vector<uint8_t>(expected.begin() + 32, expected.end()));
+		BOOST_CHECK_EQUAL(0, writer.buffered_size());
+
+		const auto actual = file.read_all();
+		BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), actual.begin(), actual.end());
+		BOOST_CHECK_THROW(writer.write_serialized(std::vector<uint8_t>(15)), serialization_error);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_write_error) {
+		record_writer<dense_struct> writer(-1);
+		writer.write(dense_struct::get_default());
+		BOOST_CHECK_THROW(writer.flush(), std::system_error);
+		BOOST_CHECK_EQUAL(0, writer.buffered_size());
+		BOOST_CHECK_THROW(writer.sync(), std::system_error);
+	}
+BOOST_AUTO_TEST_SUITE_END()
+#endif
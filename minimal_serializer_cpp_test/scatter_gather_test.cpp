@@ -0,0 +1,112 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/mpl/list.hpp>
+
+#include "minimal_serializer/scatter_gather.hpp"
+#include "serialize_test_types.hpp"
+
+using namespace std;
+using namespace minimal_serializer;
+
+namespace {
+	// Split a buffer into segments of the size cyclically including empty segments.
+	std::vector<std::vector<uint8_t>> split_segments(const size_t total_size, const std::vector<size_t>& sizes) {
+		std::vector<std::vector<uint8_t>> segments;
+		size_t size = 0;
+		for (size_t i = 0; size < total_size; ++i) {
+			const auto segment_size = std::min(sizes[i % sizes.size()], total_size - size);
+			segments.emplace_back(segment_size);
+			size += segment_size;
+		}
+		return segments;
+	}
+
+	std::vector<uint8_t> join_segments(const std::vector<std::vector<uint8_t>>& segments) {
+		std::vector<uint8_t> data;
+		for (const auto& segment : segments) {
+			data.insert(data.end(), segment.begin(), segment.end());
+		}
+		return data;
+	}
+}
+
+BOOST_AUTO_TEST_SUITE(scatter_gather_test)
+	BOOST_AUTO_TEST_CASE_TEMPLATE(test_serialize_deserialize_segments, Test, test_serializable_non_string_types) {
+		const auto expected = get_default<Test>();
+		const auto expected_data = serialize(expected);
+		for (const auto& sizes : std::vector<std::vector<size_t>>{{1}, {3, 0, 5}, {7}, {4096}}) {
+			auto segments = split_segments(expected_data.size() + 2, sizes);
+			serialize_scatter(expected, segments, 2);
+			const auto actual_data = join_segments(segments);
+			BOOST_CHECK_EQUAL_COLLECTIONS(expected_data.begin(), expected_data.end(), actual_data.begin() + 2,
+										actual_data.end());
+
+			Test actual{};
+			deserialize_gather(actual, segments, 2);
+			BOOST_CHECK(expected == actual);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_deserialize_segments_string_and_tuple) {
+		using tuple_type = std::tuple<uint8_t, boost_static_string_t<8>, int64_t>;
+		const tuple_type expected{7, boost_static_string_t<8>(reinterpret_cast<const typename boost_static_string_t<8>::value_type*>("abcdef")), -12345678};
+		const auto expected_data = serialize(expected);
+		auto segments = split_segments(expected_data.size(), {3});
+		serialize_scatter(expected, segments);
+		const auto actual_data = join_segments(segments);
+		BOOST_CHECK_EQUAL_COLLECTIONS(expected_data.begin(), expected_data.end(), actual_data.begin(),
+									actual_data.end());
+
+		tuple_type actual{};
+		deserialize_gather(actual, segments);
+		BOOST_CHECK(expected == actual);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_deserialize_segments_little_endian) {
+		std::array<uint32_t, 100> expected{};
+		for (size_t i = 0; i < expected.size(); ++i) expected[i] = static_cast<uint32_t>(i * 0x01010101);
+		auto segments = split_segments(serialized_size_v<decltype(expected)>, {13, 64});
+		serialize_scatter<byte_order::little>(expected, segments);
+		const auto data = join_segments(segments);
+		std::array<uint32_t, 100> actual{};
+		deserialize<byte_order::little>(actual, data);
+		BOOST_TEST(expected == actual, boost::test_tools::per_element());
+		actual.fill(0);
+		deserialize_gather<byte_order::little>(actual, segments);
+		BOOST_TEST(expected == actual, boost::test_tools::per_element());
+	}
+
+#ifdef MINIMAL_SERIALIZER_POSIX_IO
+	BOOST_AUTO_TEST_CASE(test_serialize_deserialize_iovec) {
+		const auto expected = nested_struct::get_default();
+		std::array<uint8_t, 50> first{};
+		std::array<uint8_t, 50> second{};
+		iovec segments[] = {{first.data(), first.size()}, {second.data(), second.size()}};
+		serialize_scatter(expected, segments, 3);
+		nested_struct actual{};
+		deserialize_gather(actual, segments, 3);
+		BOOST_CHECK(expected == actual);
+	}
+#endif
+
+	BOOST_AUTO_TEST_CASE(test_segments_out_of_range) {
+		auto segments = split_segments(serialized_size_v<nested_struct> + 1, {10});
+		BOOST_CHECK_NO_THROW(serialize_scatter(nested_struct::get_default(), segments, 1));
+		BOOST_CHECK_THROW(serialize_scatter(nested_struct::get_default(), segments, 2), serialization_error);
+		nested_struct actual{};
+		BOOST_CHECK_THROW(deserialize_gather(actual, segments, 2), serialization_error);
+	}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,213 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <array>
+#include <tuple>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/mpl/list.hpp>
+
+#include "minimal_serializer/schema_fingerprint.hpp"
+#include "serialize_test_types.hpp"
+
+using namespace std;
+using namespace minimal_serializer;
+
+namespace {
+	struct point_xy final {
+		int32_t x;
+		int32_t y;
+
+		bool operator==(const point_xy& other) const {
+			return x == other.x && y == other.y;
+		}
+
+		using serialize_targets = serialize_target_container<&point_xy::x, &point_xy::y>;
+	};
+
+	struct point_ab final {
+		int32_t a;
+		int32_t b;
+
+		using serialize_targets = serialize_target_container<&point_ab::a, &point_ab::b>;
+	};
+
+	struct point_yx final {
+		int32_t x;
+		int32_t y;
+
+		using serialize_targets = serialize_target_container<&point_yx::y, &point_yx::x>;
+	};
+
+	enum class wide_enum : uint8_t {};
+
+	struct flags final {
+		bool value1;
+		wide_enum value2;
+
+		using serialize_targets = serialize_target_container<&flags::value1, &flags::value2>;
+	};
+
+	struct packed_flags final {
+		bool value1;
+		wide_enum value2;
+
+		using serialize_targets = serialize_target_container<&packed_flags::value1, &packed_flags::value2>;
+		using serialize_packing = bit_packing;
+	};
+
+	// Same as packed_flags except for bit width of value2.
+	enum class narrow_enum : uint8_t {};
+
+	struct narrow_packed_flags final {
+		bool value1;
+		narrow_enum value2;
+
+		using serialize_targets = serialize_target_container<&narrow_packed_flags::value1, &narrow_packed_flags::value2>;
+		using serialize_packing = bit_packing;
+	};
+}
+
+namespace minimal_serializer {
+	template <>
+	struct serialized_bit_width<wide_enum> : std::integral_constant<size_t, 4> {};
+
+	template <>
+	struct serialized_bit_width<narrow_enum> : std::integral_constant<size_t, 3> {};
+}
+
+BOOST_AUTO_TEST_SUITE(schema_fingerprint_test)
+	BOOST_AUTO_TEST_CASE(test_fingerprint_is_constant) {
+		// The fingerprint must not change between builds, compilers and platforms.
+		static_assert(schema_fingerprint_v<uint32_t> == 0xaa312f255b6c6c63);
+		static_assert(schema_fingerprint_v<const point_xy&> == schema_fingerprint_v<point_xy>);
+		BOOST_CHECK_EQUAL(schema_fingerprint_v<point_xy>, schema_fingerprint_v<point_ab>);
+		BOOST_CHECK_EQUAL(schema_fingerprint_v<point_xy>, schema_fingerprint_v<point_yx>);
+		// The kind of char does not depend on whether it is signed on the platform.
+		static_assert(get_schema_kind<char>() == schema_kind::character);
+		static_assert(get_schema_kind<wchar_t>() == schema_kind::character);
+		static_assert(get_schema_kind<int8_t>() == schema_kind::signed_integer);
+		static_assert(get_schema_kind<uint8_t>() == schema_kind::unsigned_integer);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_fingerprint_differs) {
+		const std::vector<uint64_t> fingerprints{
+			schema_fingerprint_v<int32_t>,
+			schema_fingerprint_v<uint32_t>,
+			schema_fingerprint_v<int64_t>,
+			schema_fingerprint_v<bool>,
+			schema_fingerprint_v<uint8_t>,
+			schema_fingerprint_v<test_enum_class>,
+			schema_fingerprint_v<std::array<int32_t, 2>>,
+			schema_fingerprint_v<std::array<int32_t, 3>>,
+			schema_fingerprint_v<std::tuple<int32_t, int16_t>>,
+			schema_fingerprint_v<std::tuple<int16_t, int32_t>>,
+			schema_fingerprint_v<std::tuple<std::tuple<int32_t>, int16_t>>,
+			schema_fingerprint_v<std::tuple<int32_t, int32_t>>,
+			schema_fingerprint_v<point_xy>,
+			schema_fingerprint_v<flags>,
+			schema_fingerprint_v<packed_flags>,
+			schema_fingerprint_v<narrow_packed_flags>,
+			schema_fingerprint_v<boost_static_string_t<8>>,
+			schema_fingerprint_v<boost_static_string_t<9>>,
+			schema_fingerprint_v<fixed_string_t<8>>,
+			schema_fingerprint_v<nested_struct>,
+			schema_fingerprint_v<dense_struct>,
+			schema_fingerprint_v<dense_struct_reordered>,
+			schema_fingerprint_v<bit_packed_struct>,
+		};
+		for (size_t i = 0; i < fingerprints.size(); ++i) {
+			for (size_t j = i + 1; j < fingerprints.size(); ++j) {
+				BOOST_TEST_CONTEXT("i = " << i << ", j = " << j) {
+					BOOST_CHECK_NE(fingerprints[i], fingerprints[j]);
+				}
+			}
+		}
+	}
+
+#if NAMEOF_MEMBER_SUPPORTED
+	BOOST_AUTO_TEST_CASE(test_named_fingerprint) {
+		BOOST_CHECK_NE(named_schema_fingerprint_v<point_xy>, schema_fingerprint_v<point_xy>);
+		BOOST_CHECK_NE(named_schema_fingerprint_v<point_xy>, named_schema_fingerprint_v<point_ab>);
+		BOOST_CHECK_NE(named_schema_fingerprint_v<point_xy>, named_schema_fingerprint_v<point_yx>);
+		BOOST_CHECK_EQUAL(named_schema_fingerprint_v<uint32_t>, schema_fingerprint_v<uint32_t>);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_named_fingerprinted) {
+		const point_xy expected{-1, 0x12345678};
+		const auto data = serialize_fingerprinted<byte_order::big, true>(expected);
+		uint64_t fingerprint;
+		deserialize(fingerprint, data);
+		BOOST_CHECK_EQUAL(fingerprint, named_schema_fingerprint_v<point_xy>);
+
+		point_xy actual{};
+		deserialize_fingerprinted<byte_order::big, true>(actual, data);
+		BOOST_CHECK(expected == actual);
+		// Names of members are also compared.
+		point_ab renamed{};
+		BOOST_CHECK_THROW((deserialize_fingerprinted<byte_order::big, true>(renamed, data)), serialization_error);
+		BOOST_CHECK_THROW(deserialize_fingerprinted(actual, data), serialization_error);
+
+		std::vector<uint8_t> buffer(data.size());
+		serialize_fingerprinted<byte_order::big, true>(expected, buffer);
+		std::vector<uint8_t> output;
+		container_sink sink(output);
+		serialize_fingerprinted<byte_order::big, true>(expected, sink);
+		BOOST_CHECK_EQUAL_COLLECTIONS(buffer.begin(), buffer.end(), data.begin(), data.end());
+		BOOST_CHECK_EQUAL_COLLECTIONS(output.begin(), output.end(), data.begin(), data.end());
+	}
+#endif
+
+	BOOST_AUTO_TEST_CASE_TEMPLATE(test_serialize_fingerprinted, Test, test_serializable_non_string_types) {
+		const auto expected = get_default<Test>();
+		const auto data = serialize_fingerprinted(expected);
+		BOOST_CHECK_EQUAL(data.size(), (fingerprinted_serialized_size_v<Test>));
+		const auto serialized = serialize(expected);
+		BOOST_CHECK_EQUAL_COLLECTIONS(data.begin() + schema_fingerprint_size, data.end(), serialized.begin(), serialized.end());
+
+		Test actual{};
+		deserialize_fingerprinted(actual, data);
+		BOOST_CHECK(expected == actual);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_detect_schema_mismatch) {
+		const auto data = serialize_fingerprinted(point_xy{1, 2});
+		std::tuple<int64_t> other{3};
+		BOOST_CHECK_THROW(deserialize_fingerprinted(other, data), serialization_error);
+		BOOST_CHECK(other == std::tuple<int64_t>{3});
+
+		// The fingerprint is same for the same structure.
+		point_ab same{};
+		deserialize_fingerprinted(same, data);
+		BOOST_CHECK_EQUAL(same.a, 1);
+		BOOST_CHECK_EQUAL(same.b, 2);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_fingerprinted_buffer_and_sink) {
+		const point_xy expected{-1, 0x12345678};
+		constexpr auto size = fingerprinted_serialized_size_v<point_xy, byte_order::little>;
+		std::vector<uint8_t> buffer(size + 2);
+		serialize_fingerprinted<byte_order::little>(expected, buffer, 2);
+		BOOST_CHECK_THROW(serialize_fingerprinted<byte_order::little>(expected, buffer, 3), serialization_error);
+
+		std::vector<uint8_t> output{0, 0};
+		container_sink sink(output);
+		serialize_fingerprinted<byte_order::little>(expected, sink);
+		BOOST_CHECK_EQUAL_COLLECTIONS(output.begin(), output.end(), buffer.begin(), buffer.end());
+
+		point_xy actual{};
+		deserialize_fingerprinted<byte_order::little>(actual, output, 2);
+		BOOST_CHECK(expected == actual);
+		BOOST_CHECK_THROW(deserialize_fingerprinted<byte_order::little>(actual, output, 3), serialization_error);
+		// The fingerprint is also in the byte order.
+		BOOST_CHECK_THROW(deserialize_fingerprinted<byte_order::big>(actual, output, 2), serialization_error);
+	}
+BOOST_AUTO_TEST_SUITE_END()
@@ -9,6 +9,11 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 */
 
 #include <limits>
+#include <memory>
+#include <sstream>
+#if __has_include(<span>)
+#include <span>
+#endif
 
 #include <boost/test/unit_test.hpp>
 #include <boost/mpl/list.hpp>
@@ -72,6 +77,46 @@ BOOST_AUTO_TEST_SUITE(serialize_test)
 		BOOST_CHECK_THROW(minimal_serializer::deserialize(value, buffer, 13), minimal_serializer::serialization_error);
 	}
 
+	BOOST_AUTO_TEST_CASE(test_serialize_struct_offset_out_of_range) {
+		const auto value = nested_struct::get_default();
+		std::vector<uint8_t> buffer(nested_struct::size + 3);
+		BOOST_CHECK_NO_THROW(minimal_serializer::serialize(value, buffer, 3));
+		BOOST_CHECK_THROW(minimal_serializer::serialize(value, buffer, 4), minimal_serializer::serialization_error);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_deserialize_struct_offset_out_of_range) {
+		auto value = nested_struct::get_default();
+		const std::vector<uint8_t> buffer(nested_struct::size + 3);
+		BOOST_CHECK_NO_THROW(minimal_serializer::deserialize(value, buffer, 3));
+		BOOST_CHECK_THROW(minimal_serializer::deserialize(value, buffer, 4), minimal_serializer::serialization_error);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialized_offsets) {
+		constexpr auto offsets = minimal_serializer::serialized_offsets_v<nested_struct>;
+		constexpr std::array<size_t, 6> expected{0, 1, 9, 10, 50, 72};
+		BOOST_TEST(expected == offsets, boost::test_tools::per_element());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialized_offsets_tuple) {
+		constexpr auto offsets = minimal_serializer::serialized_offsets_v<std::tuple<uint8_t, int32_t, uint16_t>>;
+		constexpr std::array<size_t, 3> expected{0, 1, 5};
+		BOOST_TEST(expected == offsets, boost::test_tools::per_element());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_layout_compatible_struct_big_endian) {
+		const auto data = serialize(dense_struct::get_default());
+		const std::array<uint8_t, 16> expected{
+			0xff, 0xfe, 0x1d, 0xc0, 0x10, 0xe1, 12, 1, 0xff, 0xfe, 0x04, 0xd2, 0, 0, 0, 2
+		};
+		BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), data.begin(), data.end());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_reordered_struct_big_endian) {
+		const auto data = serialize(dense_struct_reordered::get_default());
+		const std::array<uint8_t, 8> expected{0x10, 0xe1, 0xff, 0xfe, 0x1d, 0xc0, 0xff, 0xfc};
+		BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), data.begin(), data.end());
+	}
+
 	BOOST_AUTO_TEST_CASE(test_serialize_deserialize_stream) {
 		constexpr uint64_t expected = 123456789;
 		std::ostringstream ostream(std::ios::binary);
@@ -84,6 +129,266 @@ BOOST_AUTO_TEST_SUITE(serialize_test)
 		BOOST_CHECK_EQUAL(expected, actual);
 	}
 
+	BOOST_AUTO_TEST_CASE(test_serialize_deserialize_stream_whitespace_bytes) {
+		// Bytes which are regarded as whitespace in formatted input.
+		const std::array<uint8_t, 6> expected{0x20, 0x09, 0x0a, 0x0b, 0x0c, 0x0d};
+		std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+		serialize(expected, stream);
+		serialize(expected, stream);
+
+		std::array<uint8_t, 6> actual{};
+		deserialize(actual, stream);
+		BOOST_TEST(expected == actual, boost::test_tools::per_element());
+		actual.fill(0);
+		deserialize(actual, stream);
+		BOOST_TEST(expected == actual, boost::test_tools::per_element());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_deserialize_stream_too_short) {
+		std::istringstream istream(std::string(7, '\0'), std::ios::binary);
+		uint64_t actual = 0;
+		BOOST_CHECK_THROW(deserialize(actual, istream), serialization_error);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_stream_failed) {
+		std::ostringstream ostream(std::ios::binary);
+		ostream.setstate(std::ios::badbit);
+		BOOST_CHECK_THROW(serialize(uint64_t{1}, ostream), serialization_error);
+	}
+
+	// Tests for byte orders
+	BOOST_AUTO_TEST_CASE_TEMPLATE(test_member_serialize_deserialize_little_endian, Test,
+								test_serializable_non_string_types) {
+		const auto expected = get_default<Test>();
+		Test actual{};
+		auto data = minimal_serializer::serialize<byte_order::little>(expected);
+		minimal_serializer::deserialize<byte_order::little>(actual, data);
+		BOOST_CHECK(expected == actual);
+	}
+
+	BOOST_AUTO_TEST_CASE_TEMPLATE(test_member_serialize_deserialize_native_endian, Test,
+								test_serializable_non_string_types) {
+		const auto expected = get_default<Test>();
+		Test actual{};
+		auto data = minimal_serializer::serialize<byte_order::native>(expected);
+		minimal_serializer::deserialize<byte_order::native>(actual, data);
+		BOOST_CHECK(expected == actual);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_little_endian) {
+		const std::tuple<uint32_t, int16_t, uint8_t> value{0x01020304, -2, 5};
+		const auto data = serialize<byte_order::little>(value);
+		const std::array<uint8_t, 7> expected{4, 3, 2, 1, 0xfe, 0xff, 5};
+		BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), data.begin(), data.end());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_layout_compatible_struct_little_endian) {
+		const auto data = serialize<byte_order::little>(dense_struct::get_default());
+		const std::array<uint8_t, 16> expected{
+			0xc0, 0x1d, 0xfe, 0xff, 0xe1, 0x10, 12, 1, 0xfe, 0xff, 0xd2, 0x04, 2, 0, 0, 0
+		};
+		BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), data.begin(), data.end());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_native_endian) {
+		constexpr uint64_t value = 0x0102030405060708;
+		const auto data = serialize<byte_order::native>(value);
+		std::array<uint8_t, 8> expected{};
+		std::memcpy(expected.data(), &value, sizeof(value));
+		BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), data.begin(), data.end());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_deserialize_offset_little_endian) {
+		constexpr uint64_t expected = 123456789;
+		std::vector<uint8_t> buffer(20);
+		serialize<byte_order::little>(expected, buffer, 12);
+		BOOST_CHECK_EQUAL(0x15, buffer[12]);
+		uint64_t actual = 0;
+		deserialize<byte_order::little>(actual, buffer, 12);
+		BOOST_CHECK_EQUAL(expected, actual);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialized_size_byte_order) {
+		BOOST_CHECK_EQUAL(serialized_size_v<nested_struct>, (serialized_size_v<nested_struct, byte_order::little>));
+		BOOST_CHECK_EQUAL(serialized_size_v<nested_struct>, (serialized_size_v<nested_struct, byte_order::native>));
+	}
+
+	// Tests for ranges
+	BOOST_AUTO_TEST_CASE_TEMPLATE(test_serialize_deserialize_range, Test, test_serializable_non_string_types) {
+		// Use std::array instead of std::vector because std::vector<bool> does not have data().
+		std::array<Test, 5> expected;
+		expected.fill(get_default<Test>());
+		constexpr auto size = serialized_size_v<Test>;
+		std::vector<uint8_t> buffer(3 + size * expected.size());
+		serialize_range(expected, buffer, 3);
+		for (size_t i = 0; i < expected.size(); ++i) {
+			const auto data = serialize(expected[i]);
+			BOOST_CHECK_EQUAL_COLLECTIONS(data.begin(), data.end(), buffer.begin() + 3 + i * size,
+										buffer.begin() + 3 + (i + 1) * size);
+		}
+
+		std::array<Test, 5> actual{};
+		deserialize_range(actual, buffer, 3);
+		BOOST_CHECK(expected == actual);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_deserialize_range_little_endian) {
+		const std::array<uint32_t, 3> expected{1, 0x01020304, 0xffffffff};
+		std::vector<uint8_t> buffer(12);
+		serialize_range<byte_order::little>(expected, buffer);
+		BOOST_CHECK_EQUAL(4, buffer[4]);
+		std::array<uint32_t, 3> actual{};
+		deserialize_range<byte_order::little>(actual, buffer);
+		BOOST_TEST(expected == actual, boost::test_tools::per_element());
+	}
+
+#ifdef __cpp_lib_span
+	BOOST_AUTO_TEST_CASE(test_serialize_deserialize_range_span) {
+		const std::vector<dense_struct> expected(4, dense_struct::get_default());
+		std::vector<uint8_t> buffer(serialized_size_v<dense_struct> * 2);
+		serialize_range(std::span<const dense_struct>(expected).subspan(1, 2), buffer);
+		std::vector<dense_struct> actual(4);
+		deserialize_range(std::span<dense_struct>(actual).first(2), buffer);
+		BOOST_CHECK(expected[0] == actual[0]);
+		BOOST_CHECK(expected[1] == actual[1]);
+		BOOST_CHECK(dense_struct{} == actual[2]);
+	}
+#endif
+
+	BOOST_AUTO_TEST_CASE(test_serialize_deserialize_range_empty) {
+		const std::vector<nested_struct> expected;
+		std::vector<uint8_t> buffer;
+		BOOST_CHECK_NO_THROW(serialize_range(expected, buffer));
+		std::vector<nested_struct> actual;
+		BOOST_CHECK_NO_THROW(deserialize_range(actual, buffer));
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_range_out_of_range) {
+		const std::vector<uint32_t> objects(4);
+		std::vector<uint8_t> buffer(17);
+		BOOST_CHECK_NO_THROW(serialize_range(objects, buffer, 1));
+		BOOST_CHECK_THROW(serialize_range(objects, buffer, 2), serialization_error);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_deserialize_range_out_of_range) {
+		std::vector<uint32_t> objects(4);
+		const std::vector<uint8_t> buffer(17);
+		BOOST_CHECK_NO_THROW(deserialize_range(objects, buffer, 1));
+		BOOST_CHECK_THROW(deserialize_range(objects, buffer, 2), serialization_error);
+	}
+
+	// Tests for members
+	BOOST_AUTO_TEST_CASE(test_serialize_member) {
+		auto expected = nested_struct::get_default();
+		std::vector<uint8_t> buffer(5 + serialized_size_v<nested_struct>);
+		serialize(expected, buffer, 5);
+
+		expected.value2 = 1234567890123;
+		expected.value5.value2 = 12;
+		expected.value6 = {{-1, -2, -3, -4, -5}, 9};
+		serialize_member<&nested_struct::value2>(expected.value2, buffer, 5);
+		serialize_member<&simple_struct_member_serialize::value2>(
+			expected.value5.value2, buffer, 5 + serialized_member_offset_v<&nested_struct::value5>);
+		serialize_member<&nested_struct::value6>(expected.value6, buffer, 5);
+
+		std::vector<uint8_t> expected_buffer(buffer.size());
+		serialize(expected, expected_buffer, 5);
+		BOOST_CHECK_EQUAL_COLLECTIONS(expected_buffer.begin(), expected_buffer.end(), buffer.begin(), buffer.end());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_member_little_endian) {
+		auto expected = dense_struct_reordered::get_default();
+		std::vector<uint8_t> buffer(serialized_size_v<dense_struct_reordered>);
+		serialize<byte_order::little>(expected, buffer, 0);
+		expected.value1 = 0x01020304;
+		serialize_member<byte_order::little, &dense_struct_reordered::value1>(expected.value1, buffer);
+		BOOST_CHECK_EQUAL(4, buffer[2]);
+		dense_struct_reordered actual{};
+		deserialize<byte_order::little>(actual, buffer);
+		BOOST_CHECK(expected == actual);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_member_out_of_range) {
+		std::vector<uint8_t> buffer(serialized_size_v<dense_struct>);
+		BOOST_CHECK_NO_THROW(serialize_member<&dense_struct::value6>(test_enum_class::x, buffer));
+		BOOST_CHECK_THROW(serialize_member<&dense_struct::value1>(1, buffer, 1), serialization_error);
+	}
+
+	// Tests for bit packing
+	BOOST_AUTO_TEST_CASE(test_serialize_bit_packed_struct_big_endian) {
+		static_assert(!is_serialized_layout_compatible_v<bit_packed_struct>);
+		const auto data = serialize(bit_packed_struct::get_default());
+		// Bits from the lowest: value1 = 1, value2 = 4 (3 bits), value4 = 0, value5 = 0x2aa (10 bits), value7 = 1
+		const std::array<uint8_t, 12> expected{0x49, 0xd5, 0xff, 0xfe, 0x1d, 0xc0, 0, 0, 0, 1, 0x10, 0xe1};
+		BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), data.begin(), data.end());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_deserialize_bit_packed_struct_little_endian) {
+		const auto expected = bit_packed_struct::get_default();
+		const auto data = serialize<byte_order::little>(expected);
+		BOOST_CHECK_EQUAL(data[0], 0x49);
+		BOOST_CHECK_EQUAL(data[2], 0xc0);
+		bit_packed_struct actual{};
+		deserialize<byte_order::little>(actual, data);
+		BOOST_CHECK(expected == actual);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialized_offsets_bit_packed_struct) {
+		constexpr auto offsets = minimal_serializer::serialized_offsets_v<bit_packed_struct>;
+		constexpr std::array<size_t, 8> expected{0, 0, 2, 0, 0, 6, 0, 10};
+		BOOST_TEST(expected == offsets, boost::test_tools::per_element());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_member_bit_packed) {
+		auto expected = bit_packed_struct::get_default();
+		std::vector<uint8_t> buffer(1 + serialized_size_v<bit_packed_struct>, 0xff);
+		serialize(expected, buffer, 1);
+
+		expected.value4 = true;
+		expected.value5 = test_wide_enum::c;
+		expected.value7 = false;
+		serialize_member<&bit_packed_struct::value4>(expected.value4, buffer, 1);
+		serialize_member<&bit_packed_struct::value5>(expected.value5, buffer, 1);
+		serialize_member<&bit_packed_struct::value7>(expected.value7, buffer, 1);
+
+		std::vector<uint8_t> expected_buffer(buffer.size(), 0xff);
+		serialize(expected, expected_buffer, 1);
+		BOOST_CHECK_EQUAL_COLLECTIONS(expected_buffer.begin(), expected_buffer.end(), buffer.begin(), buffer.end());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_deserialize_signed_bit_packed_enum) {
+		static_assert(serialized_size_v<signed_bit_packed_struct> == 2);
+		const signed_bit_packed_struct expected{true, test_signed_enum::minus_one, test_signed_enum::min, -1};
+		const auto data = serialize(expected);
+		// Bits from the lowest: value1 = 1, value2 = 0b111, value3 = 0b100
+		BOOST_CHECK_EQUAL(data[0], 0x4f);
+		BOOST_CHECK_EQUAL(data[1], 0xff);
+		signed_bit_packed_struct actual{};
+		deserialize(actual, data);
+		BOOST_CHECK(expected == actual);
+
+		// All values in the width are sign extended.
+		for (int value = -4; value < 4; ++value) {
+			const signed_bit_packed_struct other{false, static_cast<test_signed_enum>(value), test_signed_enum::max, 0};
+			deserialize(actual, serialize(other));
+			BOOST_CHECK_EQUAL(static_cast<int>(actual.value2), value);
+			BOOST_CHECK(actual.value3 == test_signed_enum::max);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(test_packed_bits) {
+		std::array<uint8_t, 9> block{};
+		write_packed_bits<5, 57>(block.data(), 0x1ffffffffffffff);
+		BOOST_CHECK_EQUAL(block[0], 0xe0);
+		BOOST_CHECK_EQUAL(block[7], 0x3f);
+		BOOST_CHECK_EQUAL(block[8], 0);
+		BOOST_CHECK_EQUAL((read_packed_bits<5, 57>(block.data())), 0x1ffffffffffffffu);
+		// Bits out of the width are ignored.
+		write_packed_bits<0, 3>(block.data(), 0xfa);
+		BOOST_CHECK_EQUAL(block[0], 0xe2);
+		BOOST_CHECK_EQUAL((read_packed_bits<1, 6>(block.data())), 0x31u);
+	}
+
 	// Tests for std::array
 	BOOST_AUTO_TEST_CASE(test_member_serialize_not_change_array) {
 		const std::array<int32_t, 4> expected = {-123, 23, 56, 7};
@@ -112,6 +417,43 @@ BOOST_AUTO_TEST_SUITE(serialize_test)
 		BOOST_CHECK_EQUAL(sizeof(int32_t)*4, size);
 	}
 
+	BOOST_AUTO_TEST_CASE(test_member_serialize_deserialize_large_byte_array) {
+		auto expected = std::make_unique<std::array<uint8_t, 1 << 20>>();
+		for (size_t i = 0; i < expected->size(); ++i) (*expected)[i] = static_cast<uint8_t>(i * 31);
+		std::vector<uint8_t> data(serialized_size_v<std::array<uint8_t, 1 << 20>>);
+		serialize(*expected, data, 0);
+		auto actual = std::make_unique<std::array<uint8_t, 1 << 20>>();
+		deserialize(*actual, data);
+		BOOST_CHECK(*expected == *actual);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_member_serialize_deserialize_large_struct_array) {
+		using array_t = std::array<nested_struct, 4096>;
+		auto expected = std::make_unique<array_t>();
+		expected->fill(nested_struct::get_default());
+		(*expected)[4095].value2 = 42;
+		std::vector<uint8_t> data(serialized_size_v<array_t>);
+		serialize(*expected, data, 0);
+		auto actual = std::make_unique<array_t>();
+		deserialize(*actual, data);
+		BOOST_CHECK(*expected == *actual);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_member_serialize_deserialize_tuple_array) {
+		const std::array<std::tuple<uint8_t, int32_t>, 3> expected{{{1, -1}, {2, -2}, {3, -3}}};
+		std::array<std::tuple<uint8_t, int32_t>, 3> actual{};
+		const auto data = serialize(expected);
+		const std::array<uint8_t, 15> expected_data{1, 0xff, 0xff, 0xff, 0xff, 2, 0xff, 0xff, 0xff, 0xfe, 3, 0xff, 0xff, 0xff, 0xfd};
+		BOOST_CHECK_EQUAL_COLLECTIONS(expected_data.begin(), expected_data.end(), data.begin(), data.end());
+		deserialize(actual, data);
+		BOOST_CHECK(expected == actual);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_member_serialize_size_large_array) {
+		constexpr auto size = minimal_serializer::serialized_size_v<std::array<nested_struct, 1 << 16>>;
+		BOOST_CHECK_EQUAL(nested_struct::size << 16, size);
+	}
+
 	// Tests for std::tuple
 	BOOST_AUTO_TEST_CASE(test_member_serialize_not_change_tuple) {
 		const std::tuple<int32_t, uint16_t, bool, fixed_string_t<8>> expected = {
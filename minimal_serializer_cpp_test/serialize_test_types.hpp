@@ -128,6 +128,148 @@ enum test_enum { a, b, c };
 
 enum class test_enum_class { x, y, z };
 
+// 16 bytes. Serialize targets cover all members in declaration order without padding.
+struct dense_struct final {
+	constexpr static size_t size = 16;
+
+	int32_t value1;
+	uint16_t value2;
+	uint8_t value3;
+	bool value4;
+	std::array<int16_t, 2> value5;
+	test_enum_class value6;
+
+	bool operator==(const dense_struct& other) const {
+		return value1 == other.value1 &&
+			value2 == other.value2 &&
+			value3 == other.value3 &&
+			value4 == other.value4 &&
+			value5 == other.value5 &&
+			value6 == other.value6;
+	}
+
+	static dense_struct get_default() {
+		return {-123456, 4321, 12, true, {-2, 1234}, test_enum_class::z};
+	}
+
+	using serialize_targets = minimal_serializer::serialize_target_container<
+		&dense_struct::value1, &dense_struct::value2, &dense_struct::value3, &dense_struct::value4,
+		&dense_struct::value5, &dense_struct::value6>;
+};
+
+// 8 bytes. Serialize targets cover all members without padding, but the order is different from declaration order.
+struct dense_struct_reordered final {
+	constexpr static size_t size = 8;
+
+	int32_t value1;
+	uint16_t value2;
+	int16_t value3;
+
+	bool operator==(const dense_struct_reordered& other) const {
+		return value1 == other.value1 &&
+			value2 == other.value2 &&
+			value3 == other.value3;
+	}
+
+	static dense_struct_reordered get_default() {
+		return {-123456, 4321, -4};
+	}
+
+	using serialize_targets = minimal_serializer::serialize_target_container<
+		&dense_struct_reordered::value2, &dense_struct_reordered::value1, &dense_struct_reordered::value3>;
+};
+
+// 48 bytes. Nested struct whose serialize targets cover all members in declaration order without padding.
+struct nested_dense_struct final {
+	constexpr static size_t size = 48;
+
+	dense_struct value1;
+	std::array<dense_struct, 2> value2;
+
+	bool operator==(const nested_dense_struct& other) const {
+		return value1 == other.value1 &&
+			value2 == other.value2;
+	}
+
+	static nested_dense_struct get_default() {
+		return {dense_struct::get_default(), {dense_struct::get_default(), dense_struct::get_default()}};
+	}
+
+	using serialize_targets = minimal_serializer::serialize_target_container<
+		&nested_dense_struct::value1, &nested_dense_struct::value2>;
+};
+
+enum class test_small_enum : uint8_t { a, b, c, d, e };
+
+enum class test_wide_enum : uint16_t { a = 1, b = 0x2aa, c = 0x3ff };
+
+enum class test_signed_enum : int8_t { min = -4, minus_one = -1, zero = 0, max = 3 };
+
+namespace minimal_serializer {
+	template <>
+	struct serialized_bit_width<test_small_enum> : std::integral_constant<size_t, 3> {};
+
+	template <>
+	struct serialized_bit_width<test_wide_enum> : std::integral_constant<size_t, 10> {};
+
+	template <>
+	struct serialized_bit_width<test_signed_enum> : std::integral_constant<size_t, 3> {};
+}
+
+// 12 bytes. Bools and enums with bit widths are packed into 16 bits followed by other members.
+struct bit_packed_struct final {
+	constexpr static size_t size = 12;
+
+	bool value1;
+	test_small_enum value2;
+	int32_t value3;
+	bool value4;
+	test_wide_enum value5;
+	test_enum_class value6;
+	bool value7;
+	uint16_t value8;
+
+	bool operator==(const bit_packed_struct& other) const {
+		return value1 == other.value1 &&
+			value2 == other.value2 &&
+			value3 == other.value3 &&
+			value4 == other.value4 &&
+			value5 == other.value5 &&
+			value6 == other.value6 &&
+			value7 == other.value7 &&
+			value8 == other.value8;
+	}
+
+	static bit_packed_struct get_default() {
+		return {true, test_small_enum::e, -123456, false, test_wide_enum::b, test_enum_class::y, true, 4321};
+	}
+
+	using serialize_targets = minimal_serializer::serialize_target_container<
+		&bit_packed_struct::value1, &bit_packed_struct::value2, &bit_packed_struct::value3, &bit_packed_struct::value4,
+		&bit_packed_struct::value5, &bit_packed_struct::value6, &bit_packed_struct::value7, &bit_packed_struct::value8>;
+	using serialize_packing = minimal_serializer::bit_packing;
+};
+
+// 2 bytes. Enums with a signed underlying type are packed into 7 bits followed by a byte.
+struct signed_bit_packed_struct final {
+	bool value1;
+	test_signed_enum value2;
+	test_signed_enum value3;
+	int8_t value4;
+
+	bool operator==(const signed_bit_packed_struct& other) const {
+		return value1 == other.value1 &&
+			value2 == other.value2 &&
+			value3 == other.value3 &&
+			value4 == other.value4;
+	}
+
+	using serialize_targets = minimal_serializer::serialize_target_container<
+		&signed_bit_packed_struct::value1, &signed_bit_packed_struct::value2, &signed_bit_packed_struct::value3,
+		&signed_bit_packed_struct::value4>;
+	using serialize_packing = minimal_serializer::bit_packing;
+};
+
 template <typename T>
 auto get_default() -> std::enable_if_t<std::is_arithmetic_v<T>, T> {
 	if constexpr (std::is_same_v<T, bool>) {
@@ -181,7 +323,7 @@ using test_serializable_non_string_types = boost::mpl::list<
 	float, double,
 	test_enum, test_enum_class,
 	simple_struct_member_serialize, simple_struct_global_serialize,
-	nested_struct
+	nested_struct, dense_struct, dense_struct_reordered, nested_dense_struct, bit_packed_struct
 >;
 #else
 using test_serializable_non_string_types = boost::mpl::list<
@@ -189,7 +331,7 @@ using test_serializable_non_string_types = boost::mpl::list<
 	int32_t, uint32_t, int64_t, uint64_t, bool,
 	test_enum, test_enum_class,
 	simple_struct_member_serialize, simple_struct_global_serialize,
-	nested_struct
+	nested_struct, dense_struct, dense_struct_reordered, nested_dense_struct, bit_packed_struct
 >;
 #endif
 
@@ -0,0 +1,103 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <array>
+#include <vector>
+#include <array>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "minimal_serializer/serialized_view.hpp"
+#include "serialize_test_types.hpp"
+
+using namespace std;
+using namespace minimal_serializer;
+
+BOOST_AUTO_TEST_SUITE(serialized_view_test)
+	BOOST_AUTO_TEST_CASE(test_serialized_member_offset) {
+		BOOST_CHECK_EQUAL(0, serialized_member_offset_v<&nested_struct::value1>);
+		BOOST_CHECK_EQUAL(1, serialized_member_offset_v<&nested_struct::value2>);
+		BOOST_CHECK_EQUAL(10, serialized_member_offset_v<&nested_struct::value4>);
+		BOOST_CHECK_EQUAL(72, serialized_member_offset_v<&nested_struct::value6>);
+		// The order of serialize targets is used instead of the declaration order.
+		BOOST_CHECK_EQUAL(2, serialized_member_offset_v<&dense_struct_reordered::value1>);
+		BOOST_CHECK_EQUAL(0, serialized_member_offset_v<&dense_struct_reordered::value2>);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_get_member) {
+		const auto expected = nested_struct::get_default();
+		const auto data = serialize(expected);
+		const serialized_view<nested_struct> view(data.data());
+		BOOST_CHECK_EQUAL(expected.value1, view.get<&nested_struct::value1>());
+		BOOST_CHECK_EQUAL(expected.value2, view.get<&nested_struct::value2>());
+		BOOST_CHECK_EQUAL(expected.value3, view.get<&nested_struct::value3>());
+		BOOST_CHECK(expected == view.get_object());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_get_bit_packed_member) {
+		const auto expected = bit_packed_struct::get_default();
+		const auto data = serialize<byte_order::little>(expected);
+		const serialized_view<bit_packed_struct, byte_order::little> view(data.data());
+		BOOST_CHECK_EQUAL(expected.value1, view.get<&bit_packed_struct::value1>());
+		BOOST_CHECK(expected.value2 == view.get<&bit_packed_struct::value2>());
+		BOOST_CHECK_EQUAL(expected.value3, view.get<&bit_packed_struct::value3>());
+		BOOST_CHECK(expected.value5 == view.get<&bit_packed_struct::value5>());
+		BOOST_CHECK_EQUAL(expected.value7, view.get<&bit_packed_struct::value7>());
+		BOOST_CHECK_EQUAL(expected.value8, view.get<&bit_packed_struct::value8>());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_get_nested_member) {
+		auto expected = nested_struct::get_default();
+		expected.value4[7] = 123456789;
+		expected.value6.value1[3] = -987654;
+		const auto data = serialize(expected);
+		const serialized_view<nested_struct> view(data.data());
+
+		const auto array_view = view.get<&nested_struct::value4>();
+		BOOST_CHECK_EQUAL(10, array_view.size());
+		for (size_t i = 0; i < array_view.size(); ++i) {
+			BOOST_CHECK_EQUAL(expected.value4[i], array_view[i]);
+		}
+
+		const auto struct_view = view.get<&nested_struct::value6>();
+		BOOST_CHECK_EQUAL(expected.value6.value2, struct_view.get<&simple_struct_global_serialize::value2>());
+		BOOST_CHECK_EQUAL(-987654, struct_view.get<&simple_struct_global_serialize::value1>()[3]);
+		BOOST_CHECK(expected.value5 == view.get<&nested_struct::value5>().get_object());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_array_of_struct_view) {
+		auto expected = nested_dense_struct::get_default();
+		expected.value2[1].value6 = test_enum_class::y;
+		std::vector<uint8_t> buffer(serialized_size_v<nested_dense_struct, byte_order::little> + 3);
+		serialize<byte_order::little>(expected, buffer, 3);
+		const auto view = make_serialized_view<byte_order::little, nested_dense_struct>(buffer, 3);
+		const auto element_view = view.get<&nested_dense_struct::value2>()[1];
+		BOOST_CHECK(test_enum_class::y == element_view.get<&dense_struct::value6>());
+		BOOST_CHECK_EQUAL(expected.value2[1].value5[0], element_view.get<&dense_struct::value5>()[0]);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_std_array_view) {
+		const std::array<dense_struct_reordered, 3> expected{
+			dense_struct_reordered{1, 2, 3}, dense_struct_reordered{-4, 5, -6}, dense_struct_reordered{7, 8, 9}
+		};
+		const auto data = serialize(expected);
+		const auto view = make_serialized_view<std::array<dense_struct_reordered, 3>>(data);
+		BOOST_CHECK_EQUAL(-4, view[1].get<&dense_struct_reordered::value1>());
+		BOOST_CHECK_EQUAL(-6, view[1].get<&dense_struct_reordered::value3>());
+		BOOST_CHECK(expected == view.get_object());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_make_serialized_view_out_of_range) {
+		const std::vector<uint8_t> buffer(serialized_size_v<dense_struct>);
+		BOOST_CHECK_NO_THROW(make_serialized_view<dense_struct>(buffer));
+		BOOST_CHECK_THROW(make_serialized_view<dense_struct>(buffer, 1), serialization_error);
+	}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,117 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <array>
+#include <vector>
+#include "minimal_serializer/shm_channel.hpp"
+
+#ifdef MINIMAL_SERIALIZER_SHM_CHANNEL
+#include <string>
+#include <thread>
+
+#include <sys/wait.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include "serialize_test_types.hpp"
+
+using namespace std;
+using namespace minimal_serializer;
+
+namespace {
+	// A unique name of shared memory in each test.
+	std::string get_shm_name(const char* test_name) {
+		return std::string("/minimal_serializer_test_") + test_name + "_" + std::to_string(getpid());
+	}
+}
+
+BOOST_AUTO_TEST_SUITE(shm_channel_test)
+	BOOST_AUTO_TEST_CASE(test_try_push_pop) {
+		const auto name = get_shm_name("try_push_pop");
+		shm_channel<dense_struct> producer(name.c_str(), shm_channel_mode::create, {3});
+		shm_channel<dense_struct> consumer(name.c_str(), shm_channel_mode::open);
+		BOOST_CHECK_EQUAL(4, consumer.capacity());
+
+		dense_struct actual{};
+		BOOST_CHECK(!consumer.try_pop(actual));
+		for (int32_t i = 0; i < 4; ++i) {
+			auto record = dense_struct::get_default();
+			record.value1 = i;
+			BOOST_CHECK(producer.try_push(record));
+		}
+		BOOST_CHECK(!producer.try_push(dense_struct::get_default()));
+		for (int32_t i = 0; i < 4; ++i) {
+			BOOST_CHECK(consumer.try_pop(actual));
+			BOOST_CHECK_EQUAL(i, actual.value1);
+		}
+		BOOST_CHECK(!consumer.try_pop(actual));
+	}
+
+	BOOST_AUTO_TEST_CASE(test_open_errors) {
+		const auto name = get_shm_name("open_errors");
+		BOOST_CHECK_THROW(shm_channel<dense_struct>(name.c_str(), shm_channel_mode::open), std::system_error);
+		const shm_channel<dense_struct> channel(name.c_str(), shm_channel_mode::create);
+		BOOST_CHECK_THROW(shm_channel<dense_struct>(name.c_str(), shm_channel_mode::create), std::system_error);
+		BOOST_CHECK_THROW(shm_channel<nested_struct>(name.c_str(), shm_channel_mode::open), serialization_error);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_blocking_between_threads) {
+		const auto name = get_shm_name("blocking_between_threads");
+		constexpr int32_t count = 100000;
+		// Sleep without spinning to test wake up.
+		shm_channel<dense_struct> producer(name.c_str(), shm_channel_mode::create, {16, 0});
+		shm_channel<dense_struct> consumer(name.c_str(), shm_channel_mode::open, {16, 0});
+		std::thread producer_thread([&] {
+			auto record = dense_struct::get_default();
+			for (int32_t i = 0; i < count; ++i) {
+				record.value1 = i;
+				producer.push(record);
+			}
+		});
+
+		bool in_order = true;
+		dense_struct actual{};
+		for (int32_t i = 0; i < count; ++i) {
+			consumer.pop(actual);
+			in_order = in_order && actual.value1 == i;
+		}
+		producer_thread.join();
+		BOOST_CHECK(in_order);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_between_processes) {
+		const auto name = get_shm_name("between_processes");
+		constexpr int32_t count = 10000;
+		shm_channel<nested_struct> consumer(name.c_str(), shm_channel_mode::create, {64});
+		const auto pid = fork();
+		BOOST_REQUIRE(pid >= 0);
+		if (pid == 0) {
+			shm_channel<nested_struct> producer(name.c_str(), shm_channel_mode::open);
+			auto record = nested_struct::get_default();
+			for (int32_t i = 0; i < count; ++i) {
+				record.value2 = i;
+				producer.push(record);
+			}
+			_exit(0);
+		}
+
+		bool in_order = true;
+		nested_struct actual{};
+		for (int32_t i = 0; i < count; ++i) {
+			consumer.pop(actual);
+			in_order = in_order && actual.value2 == i && actual.value6 == nested_struct::get_default().value6;
+		}
+		int status = 0;
+		waitpid(pid, &status, 0);
+		BOOST_CHECK(in_order);
+		BOOST_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+	}
+BOOST_AUTO_TEST_SUITE_END()
+#endif
@@ -0,0 +1,146 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <array>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/mpl/list.hpp>
+
+#include "minimal_serializer/sink_source.hpp"
+#include "serialize_test_types.hpp"
+
+using namespace std;
+using namespace minimal_serializer;
+
+namespace {
+	// A sink which allocates memory from a fixed arena and never grows.
+	class arena_sink final {
+	public:
+		uint8_t* reserve(const size_t size) noexcept {
+			return size <= arena_.size() - used_ ? arena_.data() + used_ : nullptr;
+		}
+
+		void commit(const size_t size) noexcept {
+			used_ += size;
+		}
+
+		[[nodiscard]] const uint8_t* data() const noexcept {
+			return arena_.data();
+		}
+
+		[[nodiscard]] size_t used() const noexcept {
+			return used_;
+		}
+
+	private:
+		std::array<uint8_t, 64> arena_{};
+		size_t used_ = 0;
+	};
+}
+
+static_assert(is_serialization_sink_v<container_sink<std::vector<uint8_t>>>);
+static_assert(is_serialization_sink_v<buffer_sink<std::array<uint8_t, 4>>>);
+static_assert(is_serialization_sink_v<arena_sink>);
+static_assert(!is_serialization_sink_v<std::vector<uint8_t>>);
+static_assert(is_deserialization_source_v<buffer_source<std::vector<uint8_t>>>);
+static_assert(!is_deserialization_source_v<arena_sink>);
+
+BOOST_AUTO_TEST_SUITE(sink_source_test)
+	BOOST_AUTO_TEST_CASE_TEMPLATE(test_serialize_deserialize_container, Test, test_serializable_non_string_types) {
+		const auto expected = get_default<Test>();
+		const auto expected_data = serialize(expected);
+		std::vector<uint8_t, default_init_allocator<uint8_t>> buffer{0xff};
+		container_sink sink(buffer);
+		serialize(expected, sink);
+		serialize(expected, sink);
+		BOOST_REQUIRE_EQUAL(buffer.size(), 1 + expected_data.size() * 2);
+		BOOST_CHECK_EQUAL(buffer[0], 0xff);
+		BOOST_CHECK_EQUAL_COLLECTIONS(expected_data.begin(), expected_data.end(), buffer.begin() + 1,
+									buffer.begin() + 1 + expected_data.size());
+
+		buffer_source source(buffer, 1);
+		Test actual1{};
+		Test actual2{};
+		deserialize(actual1, source);
+		deserialize(actual2, source);
+		BOOST_CHECK(expected == actual1);
+		BOOST_CHECK(expected == actual2);
+		BOOST_CHECK_EQUAL(source.position(), buffer.size());
+		BOOST_CHECK_THROW(deserialize(actual1, source), serialization_error);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_deserialize_little_endian) {
+		std::string buffer;
+		container_sink sink(buffer);
+		serialize<byte_order::little>(uint32_t{0x01020304}, sink);
+		BOOST_CHECK_EQUAL(buffer, std::string("\x04\x03\x02\x01", 4));
+
+		buffer_source source(buffer);
+		uint32_t actual = 0;
+		deserialize<byte_order::little>(actual, source);
+		BOOST_CHECK_EQUAL(actual, 0x01020304u);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_pmr_vector) {
+		std::array<std::byte, 256> memory{};
+		std::pmr::monotonic_buffer_resource resource(memory.data(), memory.size(), std::pmr::null_memory_resource());
+		std::vector<uint8_t, default_init_allocator<uint8_t, std::pmr::polymorphic_allocator<uint8_t>>> buffer(
+			&resource);
+		container_sink sink(buffer);
+		serialize(uint16_t{0x0102}, sink);
+		serialize(uint16_t{0x0304}, sink);
+		const std::vector<uint8_t> expected{1, 2, 3, 4};
+		BOOST_CHECK_EQUAL_COLLECTIONS(buffer.begin(), buffer.end(), expected.begin(), expected.end());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_deserialize_range) {
+		const std::vector<uint32_t> expected{1, 2, 3, 4, 5};
+		std::vector<uint8_t> buffer;
+		container_sink sink(buffer);
+		serialize_range(expected, sink);
+		BOOST_CHECK_EQUAL(buffer.size(), expected.size() * 4);
+
+		std::vector<uint32_t> actual(expected.size());
+		buffer_source source(buffer);
+		deserialize_range(actual, source);
+		BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_custom_sink) {
+		arena_sink sink;
+		for (uint64_t i = 0; i < 8; ++i) {
+			serialize(i, sink);
+		}
+		BOOST_CHECK_EQUAL(sink.used(), 64u);
+		BOOST_CHECK_THROW(serialize(uint8_t{0}, sink), serialization_error);
+
+		std::vector<uint8_t> buffer(sink.data(), sink.data() + sink.used());
+		buffer_source source(buffer, 56);
+		uint64_t actual = 0;
+		deserialize(actual, source);
+		BOOST_CHECK_EQUAL(actual, 7u);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_serialize_out_of_range) {
+		std::array<uint8_t, 6> buffer{};
+		buffer_sink sink(buffer, 1);
+		BOOST_CHECK_NO_THROW(serialize(uint32_t{0}, sink));
+		BOOST_CHECK_THROW(serialize(uint16_t{0}, sink), serialization_error);
+		BOOST_CHECK_EQUAL(sink.position(), 5u);
+		BOOST_CHECK_NO_THROW(serialize(uint8_t{0}, sink));
+
+		buffer_sink overflow_sink(buffer, 7);
+		BOOST_CHECK_THROW(serialize(uint8_t{0}, overflow_sink), serialization_error);
+	}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,96 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <thread>
+
+#include <boost/test/unit_test.hpp>
+
+#include "minimal_serializer/serialized_view.hpp"
+#include "minimal_serializer/spsc_record_ring.hpp"
+#include "serialize_test_types.hpp"
+
+using namespace std;
+using namespace minimal_serializer;
+
+BOOST_AUTO_TEST_SUITE(spsc_record_ring_test)
+	BOOST_AUTO_TEST_CASE(test_round_up_to_power_of_two) {
+		BOOST_CHECK_EQUAL(1, round_up_to_power_of_two(0));
+		BOOST_CHECK_EQUAL(1, round_up_to_power_of_two(1));
+		BOOST_CHECK_EQUAL(8, round_up_to_power_of_two(5));
+		BOOST_CHECK_EQUAL(64, round_up_to_power_of_two(64));
+	}
+
+	BOOST_AUTO_TEST_CASE(test_full_and_empty) {
+		spsc_record_ring<dense_struct> ring(3);
+		BOOST_CHECK_EQUAL(4, ring.capacity());
+		dense_struct actual{};
+		BOOST_CHECK(!ring.try_pop(actual));
+		for (int32_t i = 0; i < 4; ++i) {
+			auto record = dense_struct::get_default();
+			record.value1 = i;
+			BOOST_CHECK(ring.try_push(record));
+		}
+		BOOST_CHECK(!ring.try_push(dense_struct::get_default()));
+		BOOST_CHECK_EQUAL(4, ring.size());
+
+		for (int32_t i = 0; i < 4; ++i) {
+			BOOST_CHECK(ring.try_pop(actual));
+			BOOST_CHECK_EQUAL(i, actual.value1);
+		}
+		BOOST_CHECK(!ring.try_pop(actual));
+		BOOST_CHECK_EQUAL(0, ring.size());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_claim_and_peek) {
+		spsc_record_ring<nested_struct, byte_order::little> ring(2);
+		const auto expected = nested_struct::get_default();
+		auto* slot = ring.try_claim();
+		BOOST_REQUIRE(slot != nullptr);
+		BOOST_CHECK(ring.try_peek() == nullptr);
+		const auto data = serialize<byte_order::little>(expected);
+		std::copy(data.begin(), data.end(), slot);
+		ring.publish();
+
+		const auto* peeked = ring.try_peek();
+		BOOST_REQUIRE(peeked != nullptr);
+		const serialized_view<nested_struct, byte_order::little> view(peeked);
+		BOOST_CHECK_EQUAL(expected.value2, view.get<&nested_struct::value2>());
+		ring.release();
+		BOOST_CHECK(ring.try_peek() == nullptr);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_transfer_between_threads) {
+		constexpr int32_t count = 200000;
+		spsc_record_ring<dense_struct> ring(64);
+		std::thread producer([&] {
+			auto record = dense_struct::get_default();
+			for (int32_t i = 0; i < count; ++i) {
+				record.value1 = i;
+				while (!ring.try_push(record)) {
+					std::this_thread::yield();
+				}
+			}
+		});
+
+		bool in_order = true;
+		dense_struct actual{};
+		for (int32_t i = 0; i < count; ++i) {
+			while (!ring.try_pop(actual)) {
+				std::this_thread::yield();
+			}
+			in_order = in_order && actual.value1 == i && actual.value6 == test_enum_class::z;
+		}
+		producer.join();
+		BOOST_CHECK(in_order);
+	}
+BOOST_AUTO_TEST_SUITE_END()
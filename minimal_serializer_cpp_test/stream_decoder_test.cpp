@@ -0,0 +1,87 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <stdexcept>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/mpl/list.hpp>
+
+#include "minimal_serializer/stream_decoder.hpp"
+#include "serialize_test_types.hpp"
+
+using namespace std;
+using namespace minimal_serializer;
+
+BOOST_AUTO_TEST_SUITE(stream_decoder_test)
+	BOOST_AUTO_TEST_CASE_TEMPLATE(test_feed_chunks, Test, test_serializable_non_string_types) {
+		const auto expected = get_default<Test>();
+		const auto record_data = serialize(expected);
+		std::vector<uint8_t> data;
+		for (size_t i = 0; i < 5; ++i) {
+			data.insert(data.end(), record_data.begin(), record_data.end());
+		}
+
+		for (const size_t chunk_size : {size_t{1}, size_t{3}, record_data.size(), record_data.size() + 1, data.size()}) {
+			stream_decoder<Test> decoder;
+			size_t count = 0;
+			for (size_t position = 0; position < data.size(); position += chunk_size) {
+				const auto size = std::min(chunk_size, data.size() - position);
+				count += decoder.feed(data.data() + position, size, [&](const Test& actual) {
+					BOOST_CHECK(expected == actual);
+				});
+			}
+			BOOST_CHECK_EQUAL(count, 5u);
+			BOOST_CHECK_EQUAL(decoder.pending_size(), 0u);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(test_feed_little_endian) {
+		stream_decoder<uint32_t, byte_order::little> decoder;
+		std::vector<uint32_t> actual;
+		const auto push = [&](const uint32_t value) { actual.push_back(value); };
+		BOOST_CHECK_EQUAL(decoder.feed(std::vector<uint8_t>{4, 3, 2, 1, 8, 7}, push), 1u);
+		BOOST_CHECK_EQUAL(decoder.pending_size(), 2u);
+		BOOST_CHECK_EQUAL(decoder.feed(std::vector<uint8_t>{6}, push), 0u);
+		BOOST_CHECK_EQUAL(decoder.feed(std::vector<uint8_t>{5, 12, 11, 10, 9}, push), 2u);
+		BOOST_CHECK_EQUAL(decoder.pending_size(), 0u);
+		const std::vector<uint32_t> expected{0x01020304, 0x05060708, 0x090a0b0c};
+		BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_feed_empty_chunk) {
+		stream_decoder<uint16_t> decoder;
+		size_t count = 0;
+		BOOST_CHECK_EQUAL(decoder.feed(std::vector<uint8_t>{1}, [&](uint16_t) { ++count; }), 0u);
+		BOOST_CHECK_EQUAL(decoder.feed(std::vector<uint8_t>{}, [&](uint16_t) { ++count; }), 0u);
+		BOOST_CHECK_EQUAL(decoder.pending_size(), 1u);
+		BOOST_CHECK_EQUAL(count, 0u);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_reset) {
+		stream_decoder<uint16_t> decoder;
+		uint16_t actual = 0;
+		decoder.feed(std::vector<uint8_t>{0xff}, [&](const uint16_t value) { actual = value; });
+		decoder.reset();
+		BOOST_CHECK_EQUAL(decoder.pending_size(), 0u);
+		BOOST_CHECK_EQUAL(decoder.feed(std::vector<uint8_t>{1, 2}, [&](const uint16_t value) { actual = value; }), 1u);
+		BOOST_CHECK_EQUAL(actual, 0x0102);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_feed_callback_throws) {
+		stream_decoder<uint8_t> decoder;
+		BOOST_CHECK_THROW(decoder.feed(std::vector<uint8_t>{1, 2, 3}, [](uint8_t) { throw std::runtime_error("error"); }),
+						std::runtime_error);
+		size_t count = 0;
+		BOOST_CHECK_EQUAL(decoder.feed(std::vector<uint8_t>{4}, [&](uint8_t) { ++count; }), 1u);
+		BOOST_CHECK_EQUAL(count, 1u);
+	}
+BOOST_AUTO_TEST_SUITE_END()
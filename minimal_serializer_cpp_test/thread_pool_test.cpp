@@ -0,0 +1,80 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2019 Cdec
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <array>
+#include <vector>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "minimal_serializer/thread_pool.hpp"
+
+using namespace std;
+using namespace minimal_serializer;
+
+BOOST_AUTO_TEST_SUITE(thread_pool_test)
+	BOOST_AUTO_TEST_CASE(test_thread_count) {
+		const thread_pool pool(3);
+		BOOST_CHECK_EQUAL(3, pool.thread_count());
+		const thread_pool default_pool;
+		BOOST_CHECK_GE(default_pool.thread_count(), 1);
+	}
+
+	BOOST_AUTO_TEST_CASE(test_parallel_for_calls_each_index_once) {
+		for (const size_t thread_count : {1, 2, 3, 8}) {
+			thread_pool pool(thread_count);
+			// Run several loops in the same pool to check workers are reused.
+			for (const size_t chunk_count : {0, 1, 2, 7, 100, 1000}) {
+				std::vector<std::atomic<int>> calls(chunk_count);
+				pool.parallel_for(chunk_count, [&](const size_t i) { calls[i].fetch_add(1); });
+				for (size_t i = 0; i < chunk_count; ++i) {
+					BOOST_CHECK_EQUAL(1, calls[i].load());
+				}
+			}
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(test_parallel_for_exception) {
+		thread_pool pool(4);
+		BOOST_CHECK_THROW(pool.parallel_for(100, [](const size_t i) {
+			if (i == 42) {
+				throw std::runtime_error("error");
+			}
+		}), std::runtime_error);
+
+		// The pool is still available after an exception.
+		std::atomic<size_t> sum{0};
+		pool.parallel_for(100, [&](const size_t i) { sum.fetch_add(i); });
+		BOOST_CHECK_EQUAL(4950, sum.load());
+	}
+
+	BOOST_AUTO_TEST_CASE(test_nested_parallel_for) {
+		thread_pool pool(4);
+		std::vector<std::atomic<int>> calls(8 * 100);
+		// Nested loops run in the calling thread instead of waiting for busy threads.
+		pool.parallel_for(8, [&](const size_t i) {
+			pool.parallel_for(2, [&](const size_t j) {
+				pool.parallel_for(50, [&](const size_t k) { calls[i * 100 + j * 50 + k].fetch_add(1); });
+			});
+		});
+		for (const auto& call : calls) {
+			BOOST_CHECK_EQUAL(1, call.load());
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(test_parallel_for_too_many_chunks) {
+		if constexpr (sizeof(size_t) > 4) {
+			thread_pool pool(2);
+			BOOST_CHECK_THROW(pool.parallel_for(size_t{1} << 32, [](size_t) {}), std::length_error);
+		}
+	}
+BOOST_AUTO_TEST_SUITE_END()
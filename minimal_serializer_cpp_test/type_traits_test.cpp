@@ -28,6 +28,13 @@ using tuple_like_types = boost::mpl::list<std::array<uint32_t, 24>, std::tuple<b
 using not_tuple_like_types = boost::mpl::list<int8_t, uint8_t, int16_t, uint16_t,
 											int32_t, uint32_t, int64_t, uint64_t, bool, custom_struct>;
 
+using layout_compatible_types = boost::mpl::list<int8_t, uint64_t, bool, test_enum_class, std::array<uint32_t, 24>,
+												dense_struct, nested_dense_struct, fixed_string_t<8>>;
+
+using not_layout_compatible_types = boost::mpl::list<std::tuple<bool, int8_t, uint64_t>, std::pair<int8_t, bool>,
+													boost_static_string_t<8>, simple_struct_member_serialize,
+													nested_struct, dense_struct_reordered>;
+
 BOOST_AUTO_TEST_SUITE(type_traits_test)
 	BOOST_AUTO_TEST_CASE_TEMPLATE(test_is_tuple_like_true, Test, tuple_like_types) {
 		BOOST_CHECK_EQUAL(true, is_tuple_like_v<Test>);
@@ -45,6 +52,14 @@ BOOST_AUTO_TEST_SUITE(type_traits_test)
 		BOOST_CHECK_EQUAL(false, is_serializable_v<Test>);
 	}
 
+	BOOST_AUTO_TEST_CASE_TEMPLATE(is_serialized_layout_compatible_v_true, Test, layout_compatible_types) {
+		BOOST_CHECK_EQUAL(true, is_serialized_layout_compatible_v<Test>);
+	}
+
+	BOOST_AUTO_TEST_CASE_TEMPLATE(is_serialized_layout_compatible_v_false, Test, not_layout_compatible_types) {
+		BOOST_CHECK_EQUAL(false, is_serialized_layout_compatible_v<Test>);
+	}
+
 #if __cpp_concepts
 	BOOST_AUTO_TEST_CASE_TEMPLATE(serializable_concept_true, Test, test_serializable_types) {
 		BOOST_CHECK_EQUAL(true, serializable<Test>);